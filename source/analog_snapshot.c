@@ -0,0 +1,160 @@
+/******************************************************************************
+* File Name:   analog_snapshot.c
+*
+* Description: This file saves and restores the SAR sequencer configuration
+*              and the AMUX/HSIOM routing of the pins used by the self tests,
+*              so the tests can run between live application conversions.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+#include "cybsp.h"
+#include "analog_snapshot.h"
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    GPIO_PRT_Type *port;
+    uint32_t pin;
+} analog_snapshot_pin_ref_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+#if SELFTEST_COMPARATOR_ENABLE
+/* Pins that the comparator test connects to AMUXBUS A and B */
+static const analog_snapshot_pin_ref_t analog_snapshot_pins[ANALOG_SNAPSHOT_PIN_COUNT] =
+{
+    { CYBSP_DUT_LPCOMP_VPLUS_PORT,  CYBSP_DUT_LPCOMP_VPLUS_PIN },
+    { CYBSP_DUT_LPCOMP_VMINUS_PORT, CYBSP_DUT_LPCOMP_VMINUS_PIN },
+#if SELFTEST_COMPARATOR1_ENABLE
+    { CYBSP_DUT_LPCOMP1_VPLUS_PORT,  CYBSP_DUT_LPCOMP1_VPLUS_PIN },
+    { CYBSP_DUT_LPCOMP1_VMINUS_PORT, CYBSP_DUT_LPCOMP1_VMINUS_PIN },
+#endif
+};
+#endif
+
+/*******************************************************************************
+* Function Name: analog_snapshot_save
+********************************************************************************
+* Summary:
+* Copies the SAR sequencer registers and the pin routing into a snapshot.
+* The SAR must be idle.
+*
+* Parameters:
+*  base     - SAR instance
+*  snapshot - destination
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void analog_snapshot_save(SAR_Type *base, analog_snapshot_t *snapshot)
+{
+    uint32_t idx;
+
+    snapshot->sample_ctrl = SAR_SAMPLE_CTRL(base);
+    snapshot->chan_en = SAR_CHAN_EN(base);
+    snapshot->mux_switch0 = Cy_SAR_GetAnalogSwitch(base, CY_SAR_MUX_SWITCH0);
+    snapshot->mux_switch_sq_ctrl = SAR_MUX_SWITCH_SQ_CTRL(base);
+    snapshot->intr_mask = SAR_INTR_MASK(base);
+    for (idx = 0u; idx < CY_SAR_SEQ_NUM_CHANNELS; idx++)
+    {
+        snapshot->chan_config[idx] = SAR_CHAN_CONFIG(base, idx);
+    }
+
+#if SELFTEST_COMPARATOR_ENABLE
+    for (idx = 0u; idx < ANALOG_SNAPSHOT_PIN_COUNT; idx++)
+    {
+        snapshot->pins[idx].hsiom = Cy_GPIO_GetHSIOM(analog_snapshot_pins[idx].port,
+                analog_snapshot_pins[idx].pin);
+        snapshot->pins[idx].drive_mode = Cy_GPIO_GetDrivemode(analog_snapshot_pins[idx].port,
+                analog_snapshot_pins[idx].pin);
+    }
+#endif
+}
+
+/*******************************************************************************
+* Function Name: analog_snapshot_restore
+********************************************************************************
+* Summary:
+* Writes a snapshot back. The switches are opened before the channel
+* configuration is restored, so no intermediate routing connects two signals.
+* The SAR interrupt status left by the test conversions is cleared before the
+* interrupt mask of the application is restored.
+*
+* Parameters:
+*  base     - SAR instance
+*  snapshot - snapshot taken by analog_snapshot_save()
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void analog_snapshot_restore(SAR_Type *base, const analog_snapshot_t *snapshot)
+{
+    uint32_t idx;
+
+    Cy_SAR_SetAnalogSwitch(base, CY_SAR_MUX_SWITCH0,
+            Cy_SAR_GetAnalogSwitch(base, CY_SAR_MUX_SWITCH0), CY_SAR_SWITCH_OPEN);
+    for (idx = 0u; idx < CY_SAR_SEQ_NUM_CHANNELS; idx++)
+    {
+        SAR_CHAN_CONFIG(base, idx) = snapshot->chan_config[idx];
+    }
+    SAR_SAMPLE_CTRL(base) = snapshot->sample_ctrl;
+    SAR_CHAN_EN(base) = snapshot->chan_en;
+    SAR_MUX_SWITCH_SQ_CTRL(base) = snapshot->mux_switch_sq_ctrl;
+    Cy_SAR_SetAnalogSwitch(base, CY_SAR_MUX_SWITCH0, snapshot->mux_switch0, CY_SAR_SWITCH_CLOSE);
+    /* Drop the interrupts of the test conversions, such as end of scan, so the
+     * application handler does not run on a test result
+     */
+    Cy_SAR_ClearInterrupt(base, Cy_SAR_GetInterruptStatus(base));
+    SAR_INTR_MASK(base) = snapshot->intr_mask;
+
+#if SELFTEST_COMPARATOR_ENABLE
+    for (idx = 0u; idx < ANALOG_SNAPSHOT_PIN_COUNT; idx++)
+    {
+        Cy_GPIO_SetDrivemode(analog_snapshot_pins[idx].port, analog_snapshot_pins[idx].pin,
+                snapshot->pins[idx].drive_mode);
+        Cy_GPIO_SetHSIOM(analog_snapshot_pins[idx].port, analog_snapshot_pins[idx].pin,
+                snapshot->pins[idx].hsiom);
+    }
+#endif
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,92 @@
+/******************************************************************************
+* File Name:   analog_snapshot.h
+*
+* Description: This file is the public interface of analog_snapshot.c source
+*              file.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef ANALOG_SNAPSHOT_H_
+#define ANALOG_SNAPSHOT_H_
+
+#include <stdint.h>
+#include "cy_pdl.h"
+#include "selftest_config.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of GPIO pins whose analog routing is saved, the comparator inputs */
+#define ANALOG_SNAPSHOT_PIN_COUNT          (2u * (1u + (uint32_t)SELFTEST_COMPARATOR1_ENABLE))
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Routing of one GPIO pin */
+typedef struct
+{
+    en_hsiom_sel_t hsiom;
+    uint32_t drive_mode;
+} analog_snapshot_pin_t;
+
+/* SAR sequencer and AMUX routing borrowed by the self tests */
+typedef struct
+{
+    uint32_t sample_ctrl;
+    uint32_t chan_en;
+    uint32_t mux_switch0;
+    uint32_t mux_switch_sq_ctrl;
+    uint32_t intr_mask;
+    uint32_t chan_config[CY_SAR_SEQ_NUM_CHANNELS];
+#if SELFTEST_COMPARATOR_ENABLE
+    analog_snapshot_pin_t pins[ANALOG_SNAPSHOT_PIN_COUNT];
+#endif
+} analog_snapshot_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void analog_snapshot_save(SAR_Type *base, analog_snapshot_t *snapshot);
+void analog_snapshot_restore(SAR_Type *base, const analog_snapshot_t *snapshot);
+
+#endif /* ANALOG_SNAPSHOT_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,84 @@
+/******************************************************************************
+* File Name:   crc16.c
+*
+* Description: This file implements the CRC-16/CCITT used by the binary test
+*              protocol and the retained power-on self test record.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+#include "crc16.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CRC16_CCITT_POLY                   (0x1021u)
+
+/*******************************************************************************
+* Function Name: crc16_ccitt
+********************************************************************************
+* Summary:
+* Continues a CRC-16/CCITT calculation over a block of bytes.
+*
+* Parameters:
+*  crc  - CRC of the preceding bytes, CRC16_CCITT_INIT to start
+*  data - bytes to add
+*  size - number of bytes
+*
+* Return :
+*  uint16_t - updated CRC
+*
+*******************************************************************************/
+uint16_t crc16_ccitt(uint16_t crc, const uint8_t *data, uint32_t size)
+{
+    uint32_t bit;
+
+    while (size > 0u)
+    {
+        crc ^= (uint16_t)((uint16_t)*data << 8u);
+        for (bit = 0u; bit < 8u; bit++)
+        {
+            crc = (0u != (crc & 0x8000u)) ?
+                    (uint16_t)((crc << 1u) ^ CRC16_CCITT_POLY) : (uint16_t)(crc << 1u);
+        }
+        data++;
+        size--;
+    }
+
+    return crc;
+}
+
+/* [] END OF FILE */
@@ -50,10 +50,26 @@
 #include "cy_pdl.h"
 #include "cybsp.h"
 #include "self_test.h"
+#include "uart_tx.h"
+#include "timebase.h"
+#include "test_scheduler.h"
+#include "selftest_timing.h"
+#include "selftest_log.h"
+#include "selftest_proto.h"
+#include "selftest_drift.h"
+#include "selftest_lowpower.h"
+#include "stack_monitor.h"
+#include "selftest_post.h"
 
 /*******************************************************************************
 * Macros
 ********************************************************************************/
+/* Set to 0 to remove the UART command interface, e.g. for unattended builds
+ * that only run the background test scheduler.
+ */
+#ifndef SELFTEST_UART_CMD_ENABLE
+#define SELFTEST_UART_CMD_ENABLE           1
+#endif
 
 /*******************************************************************************
 * Global Variables
@@ -75,6 +91,10 @@
 *    5. Run ADC test
 *    6. Run OpAmp test
 *    7. The code restores the user's SAR ADC configurations
+*    8. When TEST_SCHEDULER_ENABLE is set, runs the tests periodically in the
+*       background next to the optional UART command interface
+*    9. When SELFTEST_LOWPOWER_ENABLE is set, runs the tests from WDT wakeups
+*       and stays in deep sleep in between
 *    
 * Parameters:
 *  void
@@ -88,7 +108,13 @@ int main(void)
 {
     cy_rslt_t result;
     cy_en_sar_status_t sar_res;
-    cy_stc_scb_uart_context_t CYBSP_UART_context;
+    /* Static, so the context does not take stack for the lifetime of main() */
+    static cy_stc_scb_uart_context_t CYBSP_UART_context;
+
+#if STACK_MONITOR_ENABLE
+    /* Paint the unused stack for the high-water mark measurement */
+    stack_monitor_init();
+#endif
 
     /* Initialize the device and board peripherals */
     result = cybsp_init() ;
@@ -104,9 +130,12 @@ int main(void)
     Cy_SCB_UART_Init(CYBSP_UART_HW, &CYBSP_UART_config, &CYBSP_UART_context);
     Cy_SCB_UART_Enable(CYBSP_UART_HW);
 
+    /* Route prints through the interrupt driven TX ring buffer */
+    uart_tx_init(CYBSP_UART_HW);
+
     /* \x1b[2J\x1b[;H - ANSI ESC sequence for clear screen */
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "\x1b[2J\x1b[;H");
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "\r\nClass B Safety test: Analog Peripherals\r\n");
+    uart_tx_puts("\x1b[2J\x1b[;H");
+    uart_tx_puts("\r\nClass B Safety test: Analog Peripherals\r\n");
 
     /* Initialize ADC as per config structure and enable ADC */
     sar_res = Cy_SAR_Init(CYBSP_DUT_SAR_ADC_HW, &CYBSP_DUT_SAR_ADC_config);
@@ -116,40 +145,217 @@ int main(void)
     }   
     Cy_SAR_Enable(CYBSP_DUT_SAR_ADC_HW);
 
+    /* Apply the default median filter length and hardware averaging */
+    selftest_set_measure_mode(selftest_measure_get_config());
+
+    /* Start the time base used by the POST and the test scheduler */
+    timebase_init();
+
+    /* Start the result log, restoring the records of the flash mirror */
+    selftest_log_init();
+
+#if SELFTEST_POST_ENABLE
+    /* Power-on self test, skipped on warm resets after a recent passed POST.
+     * With SELFTEST_POST_HALT_ON_FAIL, a failed POST stops the device before
+     * the application starts.
+     */
+    (void)selftest_post_run();
+    selftest_post_print();
+#if SELFTEST_POST_HALT_ON_FAIL
+    if (0u != selftest_post_get_result()->fail_mask)
+    {
+        selftest_post_halt();
+    }
+#endif
+#endif
+
     /* Display available commands */
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "Available commands \r\n");
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "1 : Run SelfTest for ADC\r\n");
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "2 : Run SelfTest for Comparator\r\n");
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "3 : Run SelfTest for OP-AMP\r\n\n");
+    uart_tx_puts("Available commands \r\n");
+#if SELFTEST_ADC_ENABLE
+    uart_tx_puts("1 : Run SelfTest for ADC\r\n");
+#endif
+#if SELFTEST_COMPARATOR_ENABLE
+    uart_tx_puts("2 : Run SelfTest for Comparator\r\n");
+#endif
+#if SELFTEST_OPAMP_ENABLE
+    uart_tx_puts("3 : Run SelfTest for OP-AMP\r\n");
+#endif
+    uart_tx_puts("4 : Show test scheduler statistics\r\n");
+#if SELFTEST_TIMING_ENABLE
+    uart_tx_puts("5 : Show self test timing statistics\r\n");
+#endif
+#if SELFTEST_SAR_TESTS_ENABLE
+    uart_tx_puts("6 : Run multi-channel SelfTest for ADC\r\n");
+    uart_tx_puts("7 : Switch ADC/OP-AMP reference between 1/3 VDD and 2/3 VDD\r\n");
+#endif
+    uart_tx_puts("8 : Dump the binary result log\r\n");
+    uart_tx_puts("9 : Show ADC/OP-AMP drift statistics\r\n");
+    uart_tx_puts("s : Show stack high-water marks of the tests\r\n");
+#if SELFTEST_POST_ENABLE
+    uart_tx_puts("r : Warm reset, reusing the retained POST result\r\n");
+#endif
+#if SELFTEST_ADC_ENABLE
+    uart_tx_puts("a : Start non-blocking ADC measurement (no STL check)\r\n");
+#endif
+#if SELFTEST_OPAMP_ENABLE
+    uart_tx_puts("b : Start non-blocking OP-AMP measurement (no STL check)\r\n");
+#endif
+    uart_tx_puts("\n");
+
+#if TEST_SCHEDULER_ENABLE
+    test_scheduler_init();
+#endif
+#if SELFTEST_LOWPOWER_ENABLE
+    selftest_lowpower_init();
+#endif
 
     for(;;)
     {
+#if TEST_SCHEDULER_ENABLE
+        test_scheduler_run();
+#endif
+
+#if SELFTEST_UART_CMD_ENABLE
         result = Cy_SCB_UART_Get(CYBSP_UART_HW);
+#if SELFTEST_LOWPOWER_ENABLE
         if (result != CY_SCB_UART_RX_NO_DATA)
         {
-            if (SELFTEST_CMD_ADC == result)
+            selftest_lowpower_notify_rx();
+        }
+#endif
+        if ((result != CY_SCB_UART_RX_NO_DATA) && (!selftest_proto_feed((uint8_t)result)))
+        {
+            if (SELFTEST_CMD_LOG_DUMP == result)
             {
-                Cy_SCB_UART_PutString(CYBSP_UART_HW, "\r\n[Command] : Run SelfTest for ADC\r\n");
+                selftest_log_dump();
+
+            }
+#if SELFTEST_ADC_ENABLE
+            else if (SELFTEST_CMD_ADC == result)
+            {
+                uart_tx_puts("\r\n[Command] : Run SelfTest for ADC\r\n");
                 adc_test();
 
             }
+#endif
+#if SELFTEST_COMPARATOR_ENABLE
             else if (SELFTEST_COMPARATOR == result)
             {
-                Cy_SCB_UART_PutString(CYBSP_UART_HW, "\r\n[Command] : Run SelfTest for Comparator\r\n");
+                uart_tx_puts("\r\n[Command] : Run SelfTest for Comparator\r\n");
                 comparator_test();
 
             }
+#endif
+#if SELFTEST_OPAMP_ENABLE
             else if (SELFTEST_CMD_OPAMP == result)
             {
-                Cy_SCB_UART_PutString(CYBSP_UART_HW, "\r\n[Command] : Run SelfTest for OP-AMP\r\n");
+                uart_tx_puts("\r\n[Command] : Run SelfTest for OP-AMP\r\n");
                 opamp_test();
 
             }
+#endif
+#if SELFTEST_ADC_ENABLE
+            else if (SELFTEST_CMD_ADC_ASYNC == result)
+            {
+                uart_tx_puts("\r\n[Command] : Start non-blocking ADC measurement\r\n");
+                if (!adc_test_start())
+                {
+                    uart_tx_puts("A non-blocking measurement is still in progress\r\n");
+                }
+
+            }
+#endif
+#if SELFTEST_OPAMP_ENABLE
+            else if (SELFTEST_CMD_OPAMP_ASYNC == result)
+            {
+                uart_tx_puts("\r\n[Command] : Start non-blocking OP-AMP measurement\r\n");
+                if (!opamp_test_start())
+                {
+                    uart_tx_puts("A non-blocking measurement is still in progress\r\n");
+                }
+
+            }
+#endif
+#if SELFTEST_SAR_TESTS_ENABLE
+            else if (SELFTEST_CMD_ADC_SCAN == result)
+            {
+                uart_tx_puts("\r\n[Command] : Run multi-channel SelfTest for ADC\r\n");
+                adc_multi_channel_test();
+
+            }
+            else if (SELFTEST_CMD_REF_TOGGLE == result)
+            {
+                if (SELFTEST_REF_VDD_1_3 == selftest_get_reference())
+                {
+                    selftest_set_reference(SELFTEST_REF_VDD_2_3);
+                    uart_tx_puts("\r\n[Command] : Reference set to 2/3 VDD\r\n");
+                }
+                else
+                {
+                    selftest_set_reference(SELFTEST_REF_VDD_1_3);
+                    uart_tx_puts("\r\n[Command] : Reference set to 1/3 VDD\r\n");
+                }
+
+            }
+#endif
+#if SELFTEST_POST_ENABLE
+            else if (SELFTEST_CMD_RESET == result)
+            {
+                uart_tx_puts("\r\n[Command] : Warm reset\r\n");
+                selftest_post_reset();
+
+            }
+#endif
+            else if (SELFTEST_CMD_STACK == result)
+            {
+                uart_tx_puts("\r\n[Command] : Show stack high-water marks of the tests\r\n");
+                selftest_print_stack_usage();
+
+            }
+            else if (SELFTEST_CMD_DRIFT == result)
+            {
+                uart_tx_puts("\r\n[Command] : Show ADC/OP-AMP drift statistics\r\n");
+                selftest_drift_print();
+
+            }
+            else if (SELFTEST_CMD_SCHED_STATS == result)
+            {
+                uart_tx_puts("\r\n[Command] : Show test scheduler statistics\r\n");
+                test_scheduler_print_stats();
+                selftest_print_init_stats();
+#if SELFTEST_LOWPOWER_ENABLE
+                selftest_lowpower_print_stats();
+#endif
+
+            }
+#if SELFTEST_TIMING_ENABLE
+            else if (SELFTEST_CMD_TIMING == result)
+            {
+                uart_tx_puts("\r\n[Command] : Show self test timing statistics\r\n");
+                selftest_timing_print();
+
+            }
+#endif
             else
             {
-                Cy_SCB_UART_PutString(CYBSP_UART_HW, "\r\nEnter a valid command\r\n");
+                uart_tx_puts("\r\nEnter a valid command\r\n");
             }
         }
+#endif
+
+#if SELFTEST_SAR_TESTS_ENABLE
+        /* Complete a non-blocking measurement once its conversion has ended */
+        (void)selftest_async_poll();
+#endif
+
+#if SELFTEST_LOG_FLASH_MIRROR
+        /* Write completed rows of the result log outside of the tests */
+        selftest_log_process();
+#endif
+
+#if SELFTEST_LOWPOWER_ENABLE
+        selftest_lowpower_process();
+#endif
     }
 
 }
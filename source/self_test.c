@@ -42,222 +42,1380 @@
 ********************************************************************************/
 #include "cybsp.h"
 #include "self_test.h"
+#include "uart_tx.h"
+#include "selftest_timing.h"
+#include "selftest_measure.h"
+#include "analog_snapshot.h"
+#include "selftest_log.h"
+#include "selftest_drift.h"
+#include "timebase.h"
+#include "stack_monitor.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Priority of the SAR end of scan interrupt used by the non-blocking tests */
+#define SELFTEST_ASYNC_INTR_PRIORITY       (3u)
+
+/* Number of LPCOMP channels covered by the comparator test points */
+#define SELFTEST_LPCOMP_INSTANCES          (1u + (uint32_t)SELFTEST_COMPARATOR1_ENABLE)
+
+/* Expands one SELFTEST_LIST() entry into its selftest_table initializer */
+#define SELFTEST_TABLE_ENTRY(name, periph_, instance_, channel_, vplus_bus_, expected_, \
+        accuracy_, prompt_, pass_msg_, fail_msg_) \
+    [SELFTEST_ID_##name] = \
+    { \
+        .periph    = SELFTEST_PERIPH_##periph_, \
+        .instance  = (instance_), \
+        .channel   = (channel_), \
+        .vplus_bus = (vplus_bus_), \
+        .expected  = (expected_), \
+        .accuracy  = (accuracy_), \
+        .prompt    = (prompt_), \
+        .pass_msg  = (pass_msg_), \
+        .fail_msg  = (fail_msg_), \
+    },
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+#if SELFTEST_COMPARATOR_ENABLE
+/* LPCOMP channel and input pins of one comparator instance */
+typedef struct
+{
+    LPCOMP_Type *base;
+    cy_en_lpcomp_channel_t channel;
+    const cy_stc_lpcomp_config_t *config;
+    GPIO_PRT_Type *vplus_port;
+    uint32_t vplus_pin;
+    GPIO_PRT_Type *vminus_port;
+    uint32_t vminus_pin;
+} selftest_lpcomp_instance_t;
+#endif
 
 /*******************************************************************************
 * Global Variables
 *******************************************************************************/
+/* Flash resident description of every test point, indexed by selftest_id_t */
+const selftest_descriptor_t selftest_table[SELFTEST_ID_COUNT] =
+{
+    SELFTEST_LIST(SELFTEST_TABLE_ENTRY)
+};
+
+/* Test point names for reports, indexed by selftest_id_t */
+const char *const selftest_names[SELFTEST_ID_COUNT] =
+{
+    SELFTEST_LIST(SELFTEST_ID_NAME)
+};
+
+#if SELFTEST_COMPARATOR_ENABLE
+/* Comparator instances, indexed by the instance of a comparator test point */
+static const selftest_lpcomp_instance_t selftest_lpcomp_instances[SELFTEST_LPCOMP_INSTANCES] =
+{
+    {
+        CYBSP_DUT_LPCOMP_HW, CYBSP_DUT_LPCOMP_CHANNEL, &CYBSP_DUT_LPCOMP_config,
+        CYBSP_DUT_LPCOMP_VPLUS_PORT, CYBSP_DUT_LPCOMP_VPLUS_PIN,
+        CYBSP_DUT_LPCOMP_VMINUS_PORT, CYBSP_DUT_LPCOMP_VMINUS_PIN
+    },
+#if SELFTEST_COMPARATOR1_ENABLE
+    {
+        CYBSP_DUT_LPCOMP1_HW, CYBSP_DUT_LPCOMP1_CHANNEL, &CYBSP_DUT_LPCOMP1_config,
+        CYBSP_DUT_LPCOMP1_VPLUS_PORT, CYBSP_DUT_LPCOMP1_VPLUS_PIN,
+        CYBSP_DUT_LPCOMP1_VMINUS_PORT, CYBSP_DUT_LPCOMP1_VMINUS_PIN
+    },
+#endif
+};
+#endif
+
+/* Peripheral contexts, initialized on first use and kept across runs */
+#if SELFTEST_COMPARATOR_ENABLE
+static cy_stc_lpcomp_context_t selftest_lpcomp_context[SELFTEST_LPCOMP_INSTANCES];
+static bool selftest_comparator_ready[SELFTEST_LPCOMP_INSTANCES];
+#endif
+#if SELFTEST_OPAMP_ENABLE
+static bool selftest_opamp_ready = false;
+#endif
+static selftest_init_stats_t selftest_init_stats;
+
+/* Per test point counters and text output switch of selftest_run() */
+static selftest_result_stats_t selftest_result_stats[SELFTEST_ID_COUNT];
+static bool selftest_quiet = false;
+
+/* Median re-measure of a failed STL check of the test being run, consumed by
+ * selftest_record_result(): taken, and inside the accuracy window
+ */
+static bool selftest_median_taken = false;
+static bool selftest_median_in_window = false;
+
+#if STACK_MONITOR_ENABLE
+/* Stack high-water mark of every test point in bytes */
+static uint32_t selftest_stack_peak[SELFTEST_ID_COUNT];
+#endif
+
+/* Reference point used by adc_test() and opamp_test() */
+static selftest_ref_t selftest_ref =
+        (0 != ADC_REF_VOLTAGE2) ? SELFTEST_REF_VDD_2_3 : SELFTEST_REF_VDD_1_3;
+
+#if SELFTEST_SAR_TESTS_ENABLE
+/* SAR and AMUX routing of the application while a non-blocking test runs */
+static analog_snapshot_t selftest_async_snapshot;
+
+/* State of the non-blocking ADC/opamp test in progress */
+static volatile bool selftest_async_eos = false;
+static selftest_async_status_t selftest_async_state = SELFTEST_ASYNC_IDLE;
+static selftest_id_t selftest_async_id = (selftest_id_t)0;
+static const char *selftest_async_pass_msg = NULL;
+static const char *selftest_async_fail_msg = NULL;
+
+/* SAR interrupt of the non-blocking tests, and the handler, priority and
+ * enable state of the application it replaces while a test runs
+ */
+static const cy_stc_sysint_t selftest_async_intr_config =
+{
+    .intrSrc = CYBSP_DUT_SAR_ADC_IRQ,
+    .intrPriority = SELFTEST_ASYNC_INTR_PRIORITY,
+};
+static cy_israddress selftest_async_prev_isr = NULL;
+static uint32_t selftest_async_prev_priority = 0u;
+static bool selftest_async_prev_enabled = false;
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if SELFTEST_OPAMP_ENABLE
+static void opamp_enable(void);
+#endif
+#if SELFTEST_COMPARATOR_ENABLE
+static void comparator_enable(uint32_t instance);
+static void comparator_route(const selftest_descriptor_t *entry);
+#endif
+static void selftest_enable_periph(const selftest_descriptor_t *entry);
+static uint8_t selftest_run_entry(const selftest_descriptor_t *entry, int16_t *measured);
+static void selftest_record_result(selftest_id_t id, uint8_t status, uint8_t log_flags,
+        int16_t measured);
+static uint32_t selftest_finish(selftest_id_t id, uint8_t status, int16_t measured);
+static uint32_t selftest_run_one(selftest_id_t id);
+#if SELFTEST_SAR_TESTS_ENABLE
+static bool selftest_in_window(int16_t measured, int16_t expected, int16_t accuracy);
+static void selftest_median_diagnose(uint8_t status, const selftest_descriptor_t *entry,
+        int16_t *measured);
+static void selftest_async_sar_isr(void);
+static bool selftest_async_start(selftest_id_t id, const char *pass_msg, const char *fail_msg);
+static void selftest_async_release_intr(void);
+static void selftest_async_wait(void);
+#endif
 
+#if SELFTEST_SAR_TESTS_ENABLE
 /*******************************************************************************
-* Function Name: adc_test
+* Function Name: selftest_in_window
 ********************************************************************************
 * Summary:
-* This function performs self test on the ADC block by  measuring the voltage on
-* a specific channel and comparing it against the expected result within a defined
-* accuracy range, this test validates the accuracy and functionality of the ADC in
-* converting analog signals to digital values. The test is performed on two reference
-* voltages 1/3 VDD) and (2/3 VDD), which is configured using the macro ADC_REF_VOLTAGE2.
+* Checks that a SAR result lies within +/- accuracy counts of the expected
+* result, the same check SelfTests_ADC() and SelfTests_Opamp() apply.
 *
 * Parameters:
-*  none
+*  measured - SAR result in counts
+*  expected - expected SAR result in counts
+*  accuracy - allowed deviation in counts
+*
+* Return :
+*  bool - true if the result is within the window
+*
+*******************************************************************************/
+static bool selftest_in_window(int16_t measured, int16_t expected, int16_t accuracy)
+{
+    int32_t deviation = (int32_t)measured - (int32_t)expected;
+
+    return ((deviation <= accuracy) && (deviation >= -(int32_t)accuracy));
+}
+
+/*******************************************************************************
+* Function Name: selftest_median_diagnose
+********************************************************************************
+* Summary:
+* When the median filter is enabled, a failed STL check is followed by a
+* median of K conversions as diagnostic data. The STL verdict stands: the
+* median only replaces the measured value that is logged, and tells whether
+* the failure may have been caused by noise. selftest_record_result() marks
+* the record with SELFTEST_LOG_STATUS_MEDIAN and counts medians inside the
+* accuracy window.
+*
+* Parameters:
+*  status   - result of the STL check
+*  entry    - test descriptor of an ADC or opamp test point
+*  measured - SAR result of the check, replaced by the median when taken
 *
 * Return :
 *  void
 *
 *******************************************************************************/
-void adc_test(void)
+static void selftest_median_diagnose(uint8_t status, const selftest_descriptor_t *entry,
+        int16_t *measured)
 {
-#if ADC_REF_VOLTAGE2
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "Ensure that a (2/3 VDDA) signal is connected to ADC channel 0.\r\n");
-    if (OK_STATUS != SelfTests_ADC(CYBSP_DUT_SAR_ADC_HW, 0x00u, ANALOG_ADC_SAR_RESULT2,
-            ANALOG_ADC_ACURACCY, VBG_CHANNEL, 1))
-    {
-        /* Process error */
-        Cy_SCB_UART_PutString(CYBSP_UART_HW, "Error: ADC SelfTest failed for 2/3 VDD signal.\r\n");
-    }
-    else
+    if ((OK_STATUS == status) || (selftest_measure_get_config()->median_k <= 1u))
     {
-        Cy_SCB_UART_PutString(CYBSP_UART_HW, "SUCCESS: ADC SelfTest passed for 2/3 VDDsignal.\r\n");
+        return;
     }
 
-#else
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "Ensure that a (1/3 VDD) signal is connected to ADC channel 0.\r\n");
+    *measured = selftest_measure_median(CYBSP_DUT_SAR_ADC_HW, entry->channel);
+    selftest_median_taken = true;
+    selftest_median_in_window = selftest_in_window(*measured, entry->expected, entry->accuracy);
+}
+#endif
 
-    if (OK_STATUS != SelfTests_ADC(CYBSP_DUT_SAR_ADC_HW, 0x00u, ANALOG_ADC_SAR_RESULT1,
-            ANALOG_ADC_ACURACCY, VBG_CHANNEL, 1))
-    {
-        /* Process error */
-        Cy_SCB_UART_PutString(CYBSP_UART_HW, "Error: ADC SelfTest failed for 1/3 VDD signal.\r\n");
-    }
-    else
+/*******************************************************************************
+* Function Name: selftest_set_measure_mode
+********************************************************************************
+* Summary:
+* Applies a measurement mode (median filter length and SAR hardware averaging)
+* to the SAR channels of the enabled ADC and opamp test points. Other
+* channels of the application are not changed.
+*
+* Parameters:
+*  config - measurement mode
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_set_measure_mode(const selftest_measure_config_t *config)
+{
+#if SELFTEST_SAR_TESTS_ENABLE
+    static const uint32_t test_channels[] =
     {
-        Cy_SCB_UART_PutString(CYBSP_UART_HW, "SUCCESS: ADC SelfTest passed for 1/3 VDD signal.\r\n");
-    }
+#if SELFTEST_ADC_ENABLE
+        VBG_CHANNEL,
+#endif
+#if SELFTEST_OPAMP_ENABLE
+        OPAMP_CHANNEL,
+#endif
+#if SELFTEST_OPAMP1_ENABLE
+        OPAMP1_CHANNEL,
+#endif
+    };
+
+    selftest_measure_set_config(CYBSP_DUT_SAR_ADC_HW, test_channels,
+            sizeof(test_channels) / sizeof(test_channels[0]), config);
+#else
+    selftest_measure_set_config(CYBSP_DUT_SAR_ADC_HW, NULL, 0u, config);
 #endif
 }
 
+#if SELFTEST_COMPARATOR_ENABLE
 /*******************************************************************************
-* Function Name: comparator_test
+* Function Name: comparator_enable
 ********************************************************************************
 * Summary:
-* This function performs self test on the comparator block by verifying if the
-* comparator output aligns with the expected result. The comparator is connected
-* to GPIO pins, thus allowing selection of two voltage references on AMUXBUS A
-* and AMUXBUS B.
+* Initializes the LPCOMP channel of a comparator instance from the device
+* configurator generated structure and enables it. Does nothing if that was
+* already done since the last selftest_invalidate_contexts().
 *
 * Parameters:
-*  none
+*  instance - comparator instance
 *
 * Return :
 *  void
 *
 *******************************************************************************/
-void comparator_test(void)
+static void comparator_enable(uint32_t instance)
 {
+    const selftest_lpcomp_instance_t *lpcomp = &selftest_lpcomp_instances[instance];
     cy_rslt_t result = CY_RSLT_SUCCESS;
-    cy_stc_lpcomp_context_t lpcomp_context;
+
+    if (selftest_comparator_ready[instance])
+    {
+        selftest_init_stats.skipped++;
+        return;
+    }
 
     /*Initialize the LPCOMP with device configurator generated structure*/
-    Cy_LPComp_Init(CYBSP_DUT_LPCOMP_HW, CYBSP_DUT_LPCOMP_CHANNEL ,
-            &CYBSP_DUT_LPCOMP_config, &lpcomp_context);
+    result = Cy_LPComp_Init(lpcomp->base, lpcomp->channel, lpcomp->config,
+            &selftest_lpcomp_context[instance]);
     if (result != CY_RSLT_SUCCESS)
     {
         CY_ASSERT(0);
     }
-    Cy_LPComp_Enable(CYBSP_DUT_LPCOMP_HW, CYBSP_DUT_LPCOMP_CHANNEL, &lpcomp_context);
+    Cy_LPComp_Enable(lpcomp->base, lpcomp->channel, &selftest_lpcomp_context[instance]);
+
+    selftest_comparator_ready[instance] = true;
+    selftest_init_stats.performed++;
+}
 
-    /* Apply lower voltage to positive input */
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "Apply lower voltage to positive input "
-            "(CYBSP_DUT_LPCOMP_VPLUS_PIN).\r\n");
+/*******************************************************************************
+* Function Name: comparator_route
+********************************************************************************
+* Summary:
+* Routes the inputs of the LPCOMP channel of a comparator test point to the
+* AMUX buses given by the entry.
+*
+* Parameters:
+*  entry - test descriptor of a comparator test point
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void comparator_route(const selftest_descriptor_t *entry)
+{
+    const selftest_lpcomp_instance_t *lpcomp = &selftest_lpcomp_instances[entry->instance];
 
-    Cy_GPIO_Pin_FastInit(CYBSP_DUT_LPCOMP_VPLUS_PORT, CYBSP_DUT_LPCOMP_VPLUS_PIN,
-            CY_GPIO_DM_ANALOG, 0u, HSIOM_SEL_AMUXA);
-    Cy_GPIO_Pin_FastInit(CYBSP_DUT_LPCOMP_VMINUS_PORT, CYBSP_DUT_LPCOMP_VMINUS_PIN,
-            CY_GPIO_DM_ANALOG, 0u, HSIOM_SEL_AMUXB);
+    Cy_GPIO_Pin_FastInit(lpcomp->vplus_port, lpcomp->vplus_pin,
+            CY_GPIO_DM_ANALOG, 0u, entry->vplus_bus);
+    Cy_GPIO_Pin_FastInit(lpcomp->vminus_port, lpcomp->vminus_pin,
+            CY_GPIO_DM_ANALOG, 0u,
+            (HSIOM_SEL_AMUXA == entry->vplus_bus) ? HSIOM_SEL_AMUXB : HSIOM_SEL_AMUXA);
+}
+#endif
 
-    if(OK_STATUS != SelfTests_Comparator(CYBSP_DUT_LPCOMP_HW, CYBSP_DUT_LPCOMP_CHANNEL,
-            ANALOG_COMP_RESULT2))
+/*******************************************************************************
+* Function Name: selftest_enable_periph
+********************************************************************************
+* Summary:
+* Enables the comparator instance or the CTB checked by a test point, if not
+* already done. The ADC test points need no bring-up, the SAR is enabled by
+* the application.
+*
+* Parameters:
+*  entry - test descriptor
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void selftest_enable_periph(const selftest_descriptor_t *entry)
+{
+#if SELFTEST_COMPARATOR_ENABLE
+    if (SELFTEST_PERIPH_COMPARATOR == entry->periph)
+    {
+        comparator_enable(entry->instance);
+    }
+#endif
+#if SELFTEST_OPAMP_ENABLE
+    if (SELFTEST_PERIPH_OPAMP == entry->periph)
     {
-        /* Process error */
-        Cy_SCB_UART_PutString(CYBSP_UART_HW, "Error: LPCOMP lower voltage test fail\r\n");
+        opamp_enable();
     }
-    else
+#endif
+    (void)entry;
+}
+
+/*******************************************************************************
+* Function Name: selftest_run_entry
+********************************************************************************
+* Summary:
+* Executes the STL check described by one table entry. The peripheral under
+* test must already be enabled. The STL does not return the measured value,
+* so it is read back from the SAR channel result or the comparator output.
+*
+* Parameters:
+*  entry    - test descriptor
+*  measured - receives the SAR counts or comparator output level
+*
+* Return :
+*  uint8_t - OK_STATUS or ERROR_STATUS
+*
+*******************************************************************************/
+static uint8_t selftest_run_entry(const selftest_descriptor_t *entry, int16_t *measured)
+{
+    uint8_t status = ERROR_STATUS;
+#if SELFTEST_COMPARATOR_ENABLE
+    const selftest_lpcomp_instance_t *lpcomp;
+#endif
+    SELFTEST_TIMING_DECLARE(stl_start);
+
+    *measured = 0;
+    switch (entry->periph)
     {
-        Cy_SCB_UART_PutString(CYBSP_UART_HW, "SUCCESS: LPCOMP lower voltage test\r\n");
+#if SELFTEST_ADC_ENABLE
+        case SELFTEST_PERIPH_ADC:
+            SELFTEST_TIMING_START(stl_start);
+            status = SelfTests_ADC(CYBSP_DUT_SAR_ADC_HW, 0x00u, entry->expected,
+                    entry->accuracy, entry->channel, 1);
+            SELFTEST_TIMING_STOP(SELFTEST_TIMING_STL_ADC, stl_start);
+            *measured = Cy_SAR_GetResult16(CYBSP_DUT_SAR_ADC_HW, entry->channel);
+            selftest_median_diagnose(status, entry, measured);
+            break;
+#endif
+
+#if SELFTEST_COMPARATOR_ENABLE
+        case SELFTEST_PERIPH_COMPARATOR:
+            lpcomp = &selftest_lpcomp_instances[entry->instance];
+            comparator_route(entry);
+
+            SELFTEST_TIMING_START(stl_start);
+            status = SelfTests_Comparator(lpcomp->base, lpcomp->channel, (uint32_t)entry->expected);
+            SELFTEST_TIMING_STOP(SELFTEST_TIMING_STL_COMPARATOR, stl_start);
+            *measured = (int16_t)Cy_LPComp_GetCompare(lpcomp->base, lpcomp->channel);
+
+            /* Release the AMUX buses for the inputs of the other instances */
+            Cy_GPIO_SetHSIOM(lpcomp->vplus_port, lpcomp->vplus_pin, HSIOM_SEL_GPIO);
+            Cy_GPIO_SetHSIOM(lpcomp->vminus_port, lpcomp->vminus_pin, HSIOM_SEL_GPIO);
+            break;
+#endif
+
+#if SELFTEST_OPAMP_ENABLE
+        case SELFTEST_PERIPH_OPAMP:
+            SELFTEST_TIMING_START(stl_start);
+            status = SelfTests_Opamp(CYBSP_DUT_SAR_ADC_HW, entry->expected,
+                    entry->accuracy, entry->channel, 1);
+            SELFTEST_TIMING_STOP(SELFTEST_TIMING_STL_OPAMP, stl_start);
+            *measured = Cy_SAR_GetResult16(CYBSP_DUT_SAR_ADC_HW, entry->channel);
+            selftest_median_diagnose(status, entry, measured);
+            break;
+#endif
+
+        default:
+            break;
     }
 
-    /* Apply higher voltage to positive input */
-    Cy_GPIO_Pin_FastInit(CYBSP_DUT_LPCOMP_VPLUS_PORT, CYBSP_DUT_LPCOMP_VPLUS_PIN,
-            CY_GPIO_DM_ANALOG, 0u, HSIOM_SEL_AMUXB);
-    Cy_GPIO_Pin_FastInit(CYBSP_DUT_LPCOMP_VMINUS_PORT, CYBSP_DUT_LPCOMP_VMINUS_PIN,
-            CY_GPIO_DM_ANALOG, 0u, HSIOM_SEL_AMUXA);
+    return status;
+}
 
-    if(OK_STATUS != SelfTests_Comparator(CYBSP_DUT_LPCOMP_HW, CYBSP_DUT_LPCOMP_CHANNEL,
-            ANALOG_COMP_RESULT1))
+/*******************************************************************************
+* Function Name: selftest_record_result
+********************************************************************************
+* Summary:
+* Updates the result counters and drift statistics of a test point and
+* appends the result to the result log. A failed result with a median
+* re-measure is logged with SELFTEST_LOG_STATUS_MEDIAN, and counted if the
+* median was inside the accuracy window.
+*
+* Parameters:
+*  id        - test point
+*  status    - OK_STATUS or ERROR_STATUS
+*  log_flags - SELFTEST_LOG_STATUS_ flags added to the status of the record
+*  measured  - SAR counts or comparator output level
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void selftest_record_result(selftest_id_t id, uint8_t status, uint8_t log_flags,
+        int16_t measured)
+{
+    selftest_result_stats[id].runs++;
+    if (OK_STATUS != status)
     {
-        /* Process error */
-        Cy_SCB_UART_PutString(CYBSP_UART_HW, "Error: LPCOMP higher voltage test fail\r\n");
+        selftest_result_stats[id].failures++;
     }
-    else
+    if (selftest_median_taken)
     {
-        Cy_SCB_UART_PutString(CYBSP_UART_HW, "SUCCESS: LPCOMP higher voltage test\r\n");
+        selftest_median_taken = false;
+        if (selftest_median_in_window)
+        {
+            selftest_result_stats[id].median_in_window++;
+        }
+        log_flags |= SELFTEST_LOG_STATUS_MEDIAN;
     }
-
+    selftest_drift_add(id, measured);
+    selftest_log_add((uint8_t)id, status | log_flags, measured, selftest_table[id].expected);
 }
 
 /*******************************************************************************
-* Function Name: opamp_test
+* Function Name: selftest_finish
 ********************************************************************************
 * Summary:
-* This function performs self test on the op-amp block by comparing the measured
-* voltage against the anticipated outcome within a defined accuracy range, this
-* test ensures that the opamp operates correctly and generates the expected output
-* voltage. The opamp is connected to the ADC and utilizes GPIO pins as a
-* multiplexer to choose various voltage references on AMUXBUS A and AMUXBUS B.
-* The test is performed on two reference voltages 1/3 VDD) and (2/3 VDD), which is
-* configured using the macro ADC_REF_VOLTAGE2.
-* .
+* Records the result of a test point and prints its pass or fail message
+* unless quiet mode is selected.
 *
 * Parameters:
-*  none
+*  id       - test point
+*  status   - OK_STATUS or ERROR_STATUS
+*  measured - SAR counts or comparator output level
 *
 * Return :
-*  void
+*  uint32_t - SELFTEST_MASK(id) if the test failed, 0 otherwise
 *
 *******************************************************************************/
-void opamp_test(void)
+static uint32_t selftest_finish(selftest_id_t id, uint8_t status, int16_t measured)
 {
-    cy_rslt_t result = CY_RSLT_SUCCESS;
+    const selftest_descriptor_t *entry = &selftest_table[id];
 
-    /* Initialization structure for Opamp0. */
-    const cy_stc_ctb_opamp_config_t opamp0Config =
+    selftest_record_result(id, status, 0u, measured);
+    if (!selftest_quiet)
     {
-            /* Opamp0 configuration */
-            .power = CYBSP_DUT_OPAMP_config.power,
-            .outputMode  = CYBSP_DUT_OPAMP_config.outputMode,
-            .pump = CYBSP_DUT_OPAMP_config.pump,
-            .compEdge  = CYBSP_DUT_OPAMP_config.compEdge,
-            .compLevel = CYBSP_DUT_OPAMP_config.compLevel,
-            .compBypass  = CYBSP_DUT_OPAMP_config.compBypass,
-            .compHyst = CYBSP_DUT_OPAMP_config.compHyst,
-            .compIntrEn  = CYBSP_DUT_OPAMP_config.compIntrEn,
-            .switchCtrl = CYBSP_DUT_OPAMP_config.switchCtrl
-    };
-    /* Define initialization structure. */
-    const cy_stc_ctb_config_t CYBSP_DUT_CTB_config =
+        uart_tx_puts((OK_STATUS != status) ? entry->fail_msg : entry->pass_msg);
+    }
+
+    return (OK_STATUS != status) ? SELFTEST_MASK(id) : 0u;
+}
+
+/*******************************************************************************
+* Function Name: selftest_run_one
+********************************************************************************
+* Summary:
+* Enables the peripheral of a test point, prints its prompt and runs it.
+* The stack used by the peripheral bring-up and the STL check is measured.
+*
+* Parameters:
+*  id - test point
+*
+* Return :
+*  uint32_t - SELFTEST_MASK(id) if the test failed, 0 otherwise
+*
+*******************************************************************************/
+static uint32_t selftest_run_one(selftest_id_t id)
+{
+    const selftest_descriptor_t *entry = &selftest_table[id];
+    uint8_t status;
+    int16_t measured;
+#if STACK_MONITOR_ENABLE
+    uint32_t stack_used;
+    uint32_t stack_sp = stack_monitor_begin();
+#endif
+
+    selftest_enable_periph(entry);
+
+    if ((!selftest_quiet) && (NULL != entry->prompt))
     {
-        /* .deepSleep          = */ false,
-        /* .oa0                = */ &opamp0Config,
-        /* .oa1                = */ NULL,
-    };
+        uart_tx_puts(entry->prompt);
+    }
 
-    /*Initialize the OPAMP0 with device configurator generated structure*/
-     result = Cy_CTB_Init(CYBSP_DUT_OPAMP_HW, &CYBSP_DUT_CTB_config);
-     if (result != CY_CTB_SUCCESS)
-     {
-         CY_ASSERT(0);
-     }
-      /*Enable Opamp0*/
-     Cy_CTB_Enable(CYBSP_DUT_OPAMP_HW);
+    status = selftest_run_entry(entry, &measured);
 
-#if ADC_REF_VOLTAGE2
-     /* Connect the (2/3 VDDA) signal to opamp channel.
-      * Use the voltage divider to achieve the (2/3 VDDA) signal.
-      */
-     Cy_SCB_UART_PutString(CYBSP_UART_HW, "Ensure that a (2/3 VDD) "
-             "signal is connected to opamp channel.\r\n");
-     if(OK_STATUS != SelfTests_Opamp(CYBSP_DUT_SAR_ADC_HW, ANALOG_OPAMP_SAR_RESULT2,
-             ANALOG_OPAMP_ACURACCY, 0x01, 1))
-     {
-         /* Process error */
-         Cy_SCB_UART_PutString(CYBSP_UART_HW, "Error: OPAMP test failed for 2/3 VDD signal.\r\n");
-     }
-     else
-     {
-         Cy_SCB_UART_PutString(CYBSP_UART_HW, "SUCCESS: OPAMP test passed for 2/3 VDD signal.\r\n");
-     }
+#if STACK_MONITOR_ENABLE
+    stack_used = stack_monitor_end(stack_sp);
+    if (stack_used > selftest_stack_peak[id])
+    {
+        selftest_stack_peak[id] = stack_used;
+    }
+#endif
 
-#else
-     /* Connect the (1/3 VDDA) signal to OpAMP channel.
-      * Use the voltage divider to achieve the (1/3 VDDA) signal.
-      */
-     Cy_SCB_UART_PutString(CYBSP_UART_HW, "Ensure that a (1/3 VDD) "
-             "signal is connected to opamp channel.\r\n");
-     if(OK_STATUS != SelfTests_Opamp(CYBSP_DUT_SAR_ADC_HW, ANALOG_OPAMP_SAR_RESULT1,
-             ANALOG_OPAMP_ACURACCY, 0x01, 1))
-     {
-         /* Process error */
-         Cy_SCB_UART_PutString(CYBSP_UART_HW, "Error: OPAMP test failed for 1/3 VDD signal.\r\n");
-     }
-     else
-     {
-         Cy_SCB_UART_PutString(CYBSP_UART_HW, "SUCCESS: OPAMP test passed for 1/3 VDD signal.\r\n");
-     }
+    return selftest_finish(id, status, measured);
+}
+
+/*******************************************************************************
+* Function Name: selftest_run
+********************************************************************************
+* Summary:
+* Generic runner for the test descriptor table. Executes every entry selected
+* in the mask in table order and prints its prompt and result, unless quiet
+* mode is selected with selftest_set_quiet(). Peripherals are
+* initialized on first use only. A non-blocking measurement in progress is
+* completed first. The SAR sequencer and AMUX routing of the application are
+* saved before and restored after the tests.
+*
+* Parameters:
+*  mask - bitmap of SELFTEST_MASK(id) values
+*
+* Return :
+*  uint32_t - bitmap of the entries that failed
+*
+*******************************************************************************/
+uint32_t selftest_run(uint32_t mask)
+{
+    uint32_t fail_mask = 0u;
+    uint32_t id;
+    analog_snapshot_t snapshot;
 
+#if SELFTEST_SAR_TESTS_ENABLE
+    selftest_async_wait();
 #endif
+    analog_snapshot_save(CYBSP_DUT_SAR_ADC_HW, &snapshot);
+
+    for (id = 0u; id < (uint32_t)SELFTEST_ID_COUNT; id++)
+    {
+        if (0u != (mask & SELFTEST_MASK(id)))
+        {
+            fail_mask |= selftest_run_one((selftest_id_t)id);
+        }
+    }
 
+    analog_snapshot_restore(CYBSP_DUT_SAR_ADC_HW, &snapshot);
+
+    return fail_mask;
+}
+
+/*******************************************************************************
+* Function Name: selftest_enable_blocks
+********************************************************************************
+* Summary:
+* Enables the comparator instances and the CTB checked by the test points of
+* a mask, so a caller can let them settle before the first test runs.
+*
+* Parameters:
+*  mask - bitmap of SELFTEST_MASK(id) values
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_enable_blocks(uint32_t mask)
+{
+    uint32_t id;
 
+    for (id = 0u; id < (uint32_t)SELFTEST_ID_COUNT; id++)
+    {
+        if (0u != (mask & SELFTEST_MASK(id)))
+        {
+            selftest_enable_periph(&selftest_table[id]);
+        }
+    }
 }
 
+/*******************************************************************************
+* Function Name: selftest_get_run_all_mask
+********************************************************************************
+* Summary:
+* Returns the test points of adc_test(), comparator_test() and opamp_test()
+* for the selected reference point, as far as they are built, on all
+* instances.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  uint32_t - bitmap of SELFTEST_MASK(id) values
+*
+*******************************************************************************/
+uint32_t selftest_get_run_all_mask(void)
+{
+    uint32_t mask = 0u;
+
+#if SELFTEST_ADC_ENABLE
+    mask |= SELFTEST_MASK(SELFTEST_ADC_ID(selftest_ref));
+#endif
+#if SELFTEST_COMPARATOR_ENABLE
+    mask |= SELFTEST_COMPARATOR_MASK;
+#endif
+#if SELFTEST_OPAMP_ENABLE
+    mask |= SELFTEST_OPAMP_MASK(selftest_ref);
+#endif
+
+    return mask;
+}
+
+/*******************************************************************************
+* Function Name: selftest_set_reference
+********************************************************************************
+* Summary:
+* Selects the reference point (1/3 VDD or 2/3 VDD) used by adc_test(),
+* opamp_test() and their non-blocking variants.
+*
+* Parameters:
+*  ref - reference point
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_set_reference(selftest_ref_t ref)
+{
+    selftest_ref = ref;
+}
+
+/*******************************************************************************
+* Function Name: selftest_get_reference
+********************************************************************************
+* Summary:
+* Returns the reference point used by adc_test() and opamp_test().
+*
+* Parameters:
+*  none
+*
+* Return :
+*  selftest_ref_t - reference point
+*
+*******************************************************************************/
+selftest_ref_t selftest_get_reference(void)
+{
+    return selftest_ref;
+}
+
+#if SELFTEST_ADC_ENABLE
+/*******************************************************************************
+* Function Name: adc_test
+********************************************************************************
+* Summary:
+* This function performs self test on the ADC block by  measuring the voltage on
+* a specific channel and comparing it against the expected result within a defined
+* accuracy range, this test validates the accuracy and functionality of the ADC in
+* converting analog signals to digital values. The test is performed on one of two
+* reference voltages (1/3 VDD) and (2/3 VDD), selected with selftest_set_reference().
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void adc_test(void)
+{
+    SELFTEST_TIMING_DECLARE(test_start);
+
+    SELFTEST_TIMING_START(test_start);
+    (void)selftest_run(SELFTEST_MASK(SELFTEST_ADC_ID(selftest_ref)));
+    SELFTEST_TIMING_STOP(SELFTEST_TIMING_ADC_TEST, test_start);
+}
+#endif
+
+#if SELFTEST_COMPARATOR_ENABLE
+/*******************************************************************************
+* Function Name: comparator_test
+********************************************************************************
+* Summary:
+* This function performs self test on the comparator block by verifying if the
+* comparator output aligns with the expected result. The comparator is connected
+* to GPIO pins, thus allowing selection of two voltage references on AMUXBUS A
+* and AMUXBUS B. Every LPCOMP channel routed in the design is tested in turn.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void comparator_test(void)
+{
+    SELFTEST_TIMING_DECLARE(test_start);
+
+    SELFTEST_TIMING_START(test_start);
+    (void)selftest_run(SELFTEST_COMPARATOR_MASK);
+    SELFTEST_TIMING_STOP(SELFTEST_TIMING_COMPARATOR_TEST, test_start);
+}
+#endif
+
+#if SELFTEST_OPAMP_ENABLE
+/*******************************************************************************
+* Function Name: opamp_enable
+********************************************************************************
+* Summary:
+* Initializes the opamp of the CTB selected by SELFTEST_OPAMP_OA, and the one
+* selected by SELFTEST_OPAMP1_OA if SELFTEST_OPAMP1_ENABLE is set, from the
+* device configurator generated structures in one CTB initialization and
+* enables the CTB. Does nothing if that was already done since the last
+* selftest_invalidate_contexts().
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void opamp_enable(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (selftest_opamp_ready)
+    {
+        selftest_init_stats.skipped++;
+        return;
+    }
+
+    /* Initialization structure of CYBSP_DUT_OPAMP */
+    const cy_stc_ctb_opamp_config_t opampConfig =
+    {
+            /* CYBSP_DUT_OPAMP configuration */
+            .power = CYBSP_DUT_OPAMP_config.power,
+            .outputMode  = CYBSP_DUT_OPAMP_config.outputMode,
+            .pump = CYBSP_DUT_OPAMP_config.pump,
+            .compEdge  = CYBSP_DUT_OPAMP_config.compEdge,
+            .compLevel = CYBSP_DUT_OPAMP_config.compLevel,
+            .compBypass  = CYBSP_DUT_OPAMP_config.compBypass,
+            .compHyst = CYBSP_DUT_OPAMP_config.compHyst,
+            .compIntrEn  = CYBSP_DUT_OPAMP_config.compIntrEn,
+            .switchCtrl = CYBSP_DUT_OPAMP_config.switchCtrl
+    };
+#if SELFTEST_OPAMP1_ENABLE
+    /* Initialization structure of CYBSP_DUT_OPAMP1 */
+    const cy_stc_ctb_opamp_config_t opamp1Config =
+    {
+            /* CYBSP_DUT_OPAMP1 configuration */
+            .power = CYBSP_DUT_OPAMP1_config.power,
+            .outputMode  = CYBSP_DUT_OPAMP1_config.outputMode,
+            .pump = CYBSP_DUT_OPAMP1_config.pump,
+            .compEdge  = CYBSP_DUT_OPAMP1_config.compEdge,
+            .compLevel = CYBSP_DUT_OPAMP1_config.compLevel,
+            .compBypass  = CYBSP_DUT_OPAMP1_config.compBypass,
+            .compHyst = CYBSP_DUT_OPAMP1_config.compHyst,
+            .compIntrEn  = CYBSP_DUT_OPAMP1_config.compIntrEn,
+            .switchCtrl = CYBSP_DUT_OPAMP1_config.switchCtrl
+    };
+#endif
+    /* Define initialization structure. */
+    const cy_stc_ctb_config_t CYBSP_DUT_CTB_config =
+    {
+        /* .deepSleep          = */ false,
+#if (0 == SELFTEST_OPAMP_OA)
+        /* .oa0                = */ &opampConfig,
+#if SELFTEST_OPAMP1_ENABLE
+        /* .oa1                = */ &opamp1Config,
+#else
+        /* .oa1                = */ NULL,
+#endif
+#else
+#if SELFTEST_OPAMP1_ENABLE
+        /* .oa0                = */ &opamp1Config,
+#else
+        /* .oa0                = */ NULL,
+#endif
+        /* .oa1                = */ &opampConfig,
+#endif
+    };
+
+    /*Initialize the opamps with device configurator generated structure*/
+     result = Cy_CTB_Init(CYBSP_DUT_OPAMP_HW, &CYBSP_DUT_CTB_config);
+     if (result != CY_CTB_SUCCESS)
+     {
+         CY_ASSERT(0);
+     }
+      /*Enable the CTB*/
+     Cy_CTB_Enable(CYBSP_DUT_OPAMP_HW);
+
+     selftest_opamp_ready = true;
+     selftest_init_stats.performed++;
+}
+#endif
+
+/*******************************************************************************
+* Function Name: selftest_invalidate_contexts
+********************************************************************************
+* Summary:
+* Forces the comparator and opamp to be initialized again on their next use.
+* Call it after the application reconfigured or disabled these blocks.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_invalidate_contexts(void)
+{
+#if SELFTEST_COMPARATOR_ENABLE
+    uint32_t instance;
+
+    for (instance = 0u; instance < SELFTEST_LPCOMP_INSTANCES; instance++)
+    {
+        selftest_comparator_ready[instance] = false;
+    }
+#endif
+#if SELFTEST_OPAMP_ENABLE
+    selftest_opamp_ready = false;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: selftest_get_init_stats
+********************************************************************************
+* Summary:
+* Returns how many peripheral initializations were performed and how many were
+* skipped because the context was still valid.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  const selftest_init_stats_t* - counters
+*
+*******************************************************************************/
+const selftest_init_stats_t *selftest_get_init_stats(void)
+{
+    return &selftest_init_stats;
+}
+
+/*******************************************************************************
+* Function Name: selftest_print_init_stats
+********************************************************************************
+* Summary:
+* Prints the peripheral initialization counters of selftest_get_init_stats().
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_print_init_stats(void)
+{
+    char line[80];
+
+    (void)snprintf(line, sizeof(line), "Peripheral init: %lu performed, %lu skipped\r\n",
+            (unsigned long)selftest_init_stats.performed, (unsigned long)selftest_init_stats.skipped);
+    uart_tx_puts(line);
+}
+
+/*******************************************************************************
+* Function Name: selftest_get_result_stats
+********************************************************************************
+* Summary:
+* Returns the run and failure counters of all test points.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  const selftest_result_stats_t * - array indexed by selftest_id_t
+*
+*******************************************************************************/
+const selftest_result_stats_t *selftest_get_result_stats(void)
+{
+    return selftest_result_stats;
+}
+
+/*******************************************************************************
+* Function Name: selftest_set_quiet
+********************************************************************************
+* Summary:
+* Suppresses the prompts and result messages of selftest_run(), e.g. while the
+* UART carries binary protocol frames. Results are still counted and logged.
+*
+* Parameters:
+*  quiet - true to suppress the text output
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_set_quiet(bool quiet)
+{
+    selftest_quiet = quiet;
+}
+
+/*******************************************************************************
+* Function Name: selftest_print_stack_usage
+********************************************************************************
+* Summary:
+* Prints the stack high-water mark of every test point that has run, flagged
+* if above STACK_MONITOR_TEST_BUDGET, followed by the overall peak and the
+* reserved stack size.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_print_stack_usage(void)
+{
+#if STACK_MONITOR_ENABLE
+    char line[80];
+    uint32_t id;
+
+    for (id = 0u; id < (uint32_t)SELFTEST_ID_COUNT; id++)
+    {
+        if (0u == selftest_stack_peak[id])
+        {
+            continue;
+        }
+        (void)snprintf(line, sizeof(line), "%-14s %4lu bytes%s\r\n", selftest_names[id],
+                (unsigned long)selftest_stack_peak[id],
+                (selftest_stack_peak[id] > STACK_MONITOR_TEST_BUDGET) ? " OVER BUDGET" : "");
+        uart_tx_puts(line);
+    }
+    (void)snprintf(line, sizeof(line), "Stack peak %lu of %lu bytes, test budget %lu bytes\r\n",
+            (unsigned long)stack_monitor_get_peak(), (unsigned long)stack_monitor_get_size(),
+            (unsigned long)STACK_MONITOR_TEST_BUDGET);
+    uart_tx_puts(line);
+#else
+    uart_tx_puts("Stack monitor disabled (STACK_MONITOR_ENABLE)\r\n");
+#endif
+}
+
+#if SELFTEST_OPAMP_ENABLE
+/*******************************************************************************
+* Function Name: opamp_test
+********************************************************************************
+* Summary:
+* This function performs self test on the op-amp block by comparing the measured
+* voltage against the anticipated outcome within a defined accuracy range, this
+* test ensures that the opamp operates correctly and generates the expected output
+* voltage. The opamp is connected to the ADC and utilizes GPIO pins as a
+* multiplexer to choose various voltage references on AMUXBUS A and AMUXBUS B.
+* The test is performed on one of two reference voltages (1/3 VDD) and (2/3 VDD),
+* selected with selftest_set_reference(), on every opamp of the CTB that is
+* routed in the design.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void opamp_test(void)
+{
+    SELFTEST_TIMING_DECLARE(test_start);
+
+    SELFTEST_TIMING_START(test_start);
+    (void)selftest_run(SELFTEST_OPAMP_MASK(selftest_ref));
+    SELFTEST_TIMING_STOP(SELFTEST_TIMING_OPAMP_TEST, test_start);
+}
+#endif
+
+#if SELFTEST_SAR_TESTS_ENABLE
+/*******************************************************************************
+* Function Name: selftest_async_sar_isr
+********************************************************************************
+* Summary:
+* SAR interrupt handler, flags the end of the scan started by a non-blocking
+* test and masks the interrupt again.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void selftest_async_sar_isr(void)
+{
+    uint32_t status = Cy_SAR_GetInterruptStatusMasked(CYBSP_DUT_SAR_ADC_HW);
+
+    Cy_SAR_ClearInterrupt(CYBSP_DUT_SAR_ADC_HW, status);
+    if (0u != (status & CY_SAR_INTR_EOS))
+    {
+        Cy_SAR_SetInterruptMask(CYBSP_DUT_SAR_ADC_HW, 0u);
+        selftest_async_eos = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: selftest_async_start
+********************************************************************************
+* Summary:
+* Starts a single shot SAR scan of the channel of a test point and returns.
+* This is a plain conversion, evaluated by selftest_async_poll() with a window
+* check, not an STL check. The SAR interrupt is taken over for the end of
+* scan, its previous handler,
+* priority and enable state are saved, and selftest_async_poll() restores
+* them when it evaluates the result.
+*
+* Parameters:
+*  id       - ADC or opamp test point
+*  pass_msg - message printed when the test passes
+*  fail_msg - message printed when the test fails
+*
+* Return :
+*  bool - false if another non-blocking test is still in progress
+*
+*******************************************************************************/
+static bool selftest_async_start(selftest_id_t id, const char *pass_msg, const char *fail_msg)
+{
+    IRQn_Type irq = selftest_async_intr_config.intrSrc;
+
+    if (SELFTEST_ASYNC_BUSY == selftest_async_state)
+    {
+        return false;
+    }
+
+    selftest_async_id = id;
+    selftest_async_pass_msg = pass_msg;
+    selftest_async_fail_msg = fail_msg;
+    selftest_async_eos = false;
+    selftest_async_state = SELFTEST_ASYNC_BUSY;
+    analog_snapshot_save(CYBSP_DUT_SAR_ADC_HW, &selftest_async_snapshot);
+
+    selftest_async_prev_isr = Cy_SysInt_GetVector(irq);
+    selftest_async_prev_priority = NVIC_GetPriority(irq);
+    selftest_async_prev_enabled = (0u != NVIC_GetEnableIRQ(irq));
+    NVIC_DisableIRQ(irq);
+    if (CY_SYSINT_SUCCESS != Cy_SysInt_Init(&selftest_async_intr_config, &selftest_async_sar_isr))
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Convert only the channel of the test point */
+    Cy_SAR_SetChanMask(CYBSP_DUT_SAR_ADC_HW, 1uL << selftest_table[id].channel);
+    Cy_SAR_ClearInterrupt(CYBSP_DUT_SAR_ADC_HW, CY_SAR_INTR_EOS);
+    Cy_SAR_SetInterruptMask(CYBSP_DUT_SAR_ADC_HW, CY_SAR_INTR_EOS);
+    NVIC_ClearPendingIRQ(irq);
+    NVIC_EnableIRQ(irq);
+    Cy_SAR_StartConvert(CYBSP_DUT_SAR_ADC_HW, CY_SAR_START_CONVERT_SINGLE_SHOT);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: selftest_async_release_intr
+********************************************************************************
+* Summary:
+* Hands the SAR interrupt back to the application: drops the end of scan
+* interrupt of the measurement if it is still pending, restores the handler
+* and priority saved by selftest_async_start() and enables the interrupt
+* again if it was enabled before.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void selftest_async_release_intr(void)
+{
+    IRQn_Type irq = selftest_async_intr_config.intrSrc;
+
+    NVIC_DisableIRQ(irq);
+    NVIC_ClearPendingIRQ(irq);
+    (void)Cy_SysInt_SetVector(irq, selftest_async_prev_isr);
+    NVIC_SetPriority(irq, selftest_async_prev_priority);
+    if (selftest_async_prev_enabled)
+    {
+        NVIC_EnableIRQ(irq);
+    }
+}
+
+/*******************************************************************************
+* Function Name: selftest_async_wait
+********************************************************************************
+* Summary:
+* Completes a non-blocking measurement in progress, so that the blocking
+* tests do not reconfigure the SAR under it. The conversion takes a few
+* microseconds; selftest_async_poll() also sees its end with the SAR
+* interrupt masked.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void selftest_async_wait(void)
+{
+    while (SELFTEST_ASYNC_BUSY == selftest_async_poll())
+    {
+    }
+}
+#endif
+
+#if SELFTEST_ADC_ENABLE
+/*******************************************************************************
+* Function Name: adc_test_start
+********************************************************************************
+* Summary:
+* Non-blocking measurement of the ADC reference point. Starts the conversion
+* of the reference voltage on VBG_CHANNEL and returns immediately. Call
+* selftest_async_poll() until it no longer returns SELFTEST_ASYNC_BUSY; the
+* CPU may sleep in between as the end of scan interrupt wakes it up. The
+* result is a window check of one conversion, not the STL check of
+* adc_test().
+*
+* Parameters:
+*  none
+*
+* Return :
+*  bool - false if another non-blocking test is still in progress
+*
+*******************************************************************************/
+bool adc_test_start(void)
+{
+    return selftest_async_start(SELFTEST_ADC_ID(selftest_ref),
+            "SUCCESS: ADC measurement in window (non-blocking, no STL check).\r\n",
+            "Error: ADC measurement out of window (non-blocking, no STL check).\r\n");
+}
+#endif
+
+#if SELFTEST_OPAMP_ENABLE
+/*******************************************************************************
+* Function Name: opamp_test_start
+********************************************************************************
+* Summary:
+* Non-blocking measurement of CYBSP_DUT_OPAMP. Enables the opamps, starts the
+* conversion of its output on OPAMP_CHANNEL and returns immediately. Complete
+* it with selftest_async_poll(). The result is a window check of one
+* conversion, not the STL check of opamp_test().
+*
+* Parameters:
+*  none
+*
+* Return :
+*  bool - false if another non-blocking test is still in progress
+*
+*******************************************************************************/
+bool opamp_test_start(void)
+{
+    if (SELFTEST_ASYNC_BUSY == selftest_async_state)
+    {
+        return false;
+    }
+
+    opamp_enable();
+
+    return selftest_async_start(SELFTEST_OPAMP_ID(selftest_ref),
+            "SUCCESS: OPAMP measurement in window (non-blocking, no STL check).\r\n",
+            "Error: OPAMP measurement out of window (non-blocking, no STL check).\r\n");
+}
+#endif
+
+#if SELFTEST_SAR_TESTS_ENABLE
+/*******************************************************************************
+* Function Name: selftest_async_poll
+********************************************************************************
+* Summary:
+* Completes the non-blocking measurement once the SAR scan has finished. The
+* measured result must lie within the accuracy window around the expected
+* result. This is not an STL check: SelfTests_ADC() and SelfTests_Opamp()
+* block until their own conversions end. The result is logged with
+* SELFTEST_LOG_STATUS_NON_STL. The end of scan is taken from the interrupt
+* handler or, with the interrupt masked, from the SAR interrupt status.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  selftest_async_status_t - SELFTEST_ASYNC_BUSY while the conversion runs,
+*  then SELFTEST_ASYNC_PASS or SELFTEST_ASYNC_FAIL until the next start
+*
+*******************************************************************************/
+selftest_async_status_t selftest_async_poll(void)
+{
+    const selftest_descriptor_t *entry = &selftest_table[selftest_async_id];
+    int16_t measured;
+
+    if ((SELFTEST_ASYNC_BUSY == selftest_async_state) && (selftest_async_eos ||
+        (0u != (Cy_SAR_GetInterruptStatus(CYBSP_DUT_SAR_ADC_HW) & CY_SAR_INTR_EOS))))
+    {
+        measured = Cy_SAR_GetResult16(CYBSP_DUT_SAR_ADC_HW, entry->channel);
+        if (selftest_in_window(measured, entry->expected, entry->accuracy))
+        {
+            selftest_async_state = SELFTEST_ASYNC_PASS;
+            uart_tx_puts(selftest_async_pass_msg);
+        }
+        else
+        {
+            /* Process error */
+            selftest_async_state = SELFTEST_ASYNC_FAIL;
+            uart_tx_puts(selftest_async_fail_msg);
+        }
+        Cy_SAR_SetInterruptMask(CYBSP_DUT_SAR_ADC_HW, 0u);
+        Cy_SAR_ClearInterrupt(CYBSP_DUT_SAR_ADC_HW, CY_SAR_INTR_EOS);
+        analog_snapshot_restore(CYBSP_DUT_SAR_ADC_HW, &selftest_async_snapshot);
+        selftest_async_release_intr();
+        selftest_record_result(selftest_async_id,
+                (SELFTEST_ASYNC_PASS == selftest_async_state) ? OK_STATUS : ERROR_STATUS,
+                SELFTEST_LOG_STATUS_NON_STL, measured);
+    }
+
+    return selftest_async_state;
+}
+
+/*******************************************************************************
+* Function Name: adc_scan_test
+********************************************************************************
+* Summary:
+* Checks several SAR channels in one hardware pass. The sequencer is set up to
+* scan all listed channels, a single shot scan converts them back to back, and
+* each result is compared against its own expected value and accuracy window.
+* Like every other test point, each result goes to the counters, drift
+* statistics and result log of its test point, marked with
+* SELFTEST_LOG_STATUS_NON_STL as it is a window check, not an STL check. The
+* channel enable mask of the SAR is restored afterwards.
+*
+* Parameters:
+*  channels - channels to check with their expected result and accuracy
+*  count    - number of entries, at most CY_SAR_SEQ_NUM_CHANNELS
+*
+* Return :
+*  uint32_t - bitmap with bit n set if entry n passed
+*
+*******************************************************************************/
+uint32_t adc_scan_test(const adc_scan_channel_t *channels, uint32_t count)
+{
+    uint32_t saved_mask = SAR_CHAN_EN(CYBSP_DUT_SAR_ADC_HW);
+    uint32_t scan_mask = 0u;
+    uint32_t pass_map = 0u;
+    uint32_t idx;
+    int16_t measured;
+    bool converted;
+
+    selftest_async_wait();
+    if (count > CY_SAR_SEQ_NUM_CHANNELS)
+    {
+        count = CY_SAR_SEQ_NUM_CHANNELS;
+    }
+    for (idx = 0u; idx < count; idx++)
+    {
+        scan_mask |= 1uL << channels[idx].channel;
+    }
+
+    Cy_SAR_SetChanMask(CYBSP_DUT_SAR_ADC_HW, scan_mask);
+    Cy_SAR_StartConvert(CYBSP_DUT_SAR_ADC_HW, CY_SAR_START_CONVERT_SINGLE_SHOT);
+    converted = (CY_SAR_SUCCESS == Cy_SAR_IsEndConversion(CYBSP_DUT_SAR_ADC_HW, CY_SAR_WAIT_FOR_RESULT));
+    for (idx = 0u; idx < count; idx++)
+    {
+        measured = converted ? Cy_SAR_GetResult16(CYBSP_DUT_SAR_ADC_HW, channels[idx].channel) : 0;
+        if (converted && selftest_in_window(measured, channels[idx].expected, channels[idx].accuracy))
+        {
+            pass_map |= 1uL << idx;
+        }
+        selftest_record_result(channels[idx].id,
+                (0u != (pass_map & (1uL << idx))) ? OK_STATUS : ERROR_STATUS,
+                SELFTEST_LOG_STATUS_NON_STL, measured);
+    }
+    Cy_SAR_SetChanMask(CYBSP_DUT_SAR_ADC_HW, saved_mask);
+
+    return pass_map;
+}
+
+/*******************************************************************************
+* Function Name: adc_multi_channel_test
+********************************************************************************
+* Summary:
+* Runs adc_scan_test() on the ADC reference channel and the opamp output
+* channel, as far as these tests are built, and prints the result of each
+* channel.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void adc_multi_channel_test(void)
+{
+#if SELFTEST_ADC_ENABLE
+    const selftest_descriptor_t *adc = &selftest_table[SELFTEST_ADC_ID(selftest_ref)];
+#endif
+#if SELFTEST_OPAMP_ENABLE
+    const selftest_descriptor_t *opamp = &selftest_table[SELFTEST_OPAMP_ID(selftest_ref)];
+#endif
+#if SELFTEST_OPAMP1_ENABLE
+    const selftest_descriptor_t *opamp1 = &selftest_table[SELFTEST_OPAMP1_ID(selftest_ref)];
+#endif
+    const adc_scan_channel_t adc_scan_channels[] =
+    {
+#if SELFTEST_ADC_ENABLE
+        { SELFTEST_ADC_ID(selftest_ref), adc->channel, adc->expected, adc->accuracy },
+#endif
+#if SELFTEST_OPAMP_ENABLE
+        { SELFTEST_OPAMP_ID(selftest_ref), opamp->channel, opamp->expected, opamp->accuracy },
+#endif
+#if SELFTEST_OPAMP1_ENABLE
+        { SELFTEST_OPAMP1_ID(selftest_ref), opamp1->channel, opamp1->expected, opamp1->accuracy },
+#endif
+    };
+    const uint32_t count = sizeof(adc_scan_channels) / sizeof(adc_scan_channels[0]);
+    char line[64];
+    uint32_t pass_map;
+    uint32_t idx;
+    SELFTEST_TIMING_DECLARE(test_start);
+
+    SELFTEST_TIMING_START(test_start);
+#if SELFTEST_OPAMP_ENABLE
+    opamp_enable();
+#endif
+    pass_map = adc_scan_test(adc_scan_channels, count);
+    SELFTEST_TIMING_STOP(SELFTEST_TIMING_ADC_SCAN_TEST, test_start);
+
+    for (idx = 0u; idx < count; idx++)
+    {
+        (void)snprintf(line, sizeof(line), "%s: ADC channel %lu scan test\r\n",
+                (0u != (pass_map & (1uL << idx))) ? "SUCCESS" : "Error",
+                (unsigned long)adc_scan_channels[idx].channel);
+        uart_tx_puts(line);
+    }
+}
+#endif
 
 /* [] END OF FILE */
 
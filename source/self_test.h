@@ -47,11 +47,10 @@
 #define SELF_TEST_H_
 
 #include <stdio.h>
+#include <stdbool.h>
 #include "SelfTest.h"
-
-/*******************************************************************************
-* Global Variables
-*******************************************************************************/
+#include "selftest_config.h"
+#include "selftest_measure.h"
 
 /*******************************************************************************
 * Macros
@@ -60,19 +59,264 @@
 #define SELFTEST_CMD_ADC ('1')
 #define SELFTEST_COMPARATOR ('2')
 #define SELFTEST_CMD_OPAMP ('3')
+#define SELFTEST_CMD_SCHED_STATS ('4')
+#define SELFTEST_CMD_TIMING ('5')
+#define SELFTEST_CMD_ADC_SCAN ('6')
+#define SELFTEST_CMD_REF_TOGGLE ('7')
+#define SELFTEST_CMD_LOG_DUMP ('8')
+#define SELFTEST_CMD_DRIFT ('9')
+#define SELFTEST_CMD_STACK ('s')
+#define SELFTEST_CMD_RESET ('r')
+#define SELFTEST_CMD_ADC_ASYNC ('a')
+#define SELFTEST_CMD_OPAMP_ASYNC ('b')
 
-/* in milliseconds */
+/* Reference point selected at startup: 0 = (1/3 VDD), 1 = (2/3 VDD).
+ * Use selftest_set_reference() or command 7 to change it at run time.
+ */
 #define ADC_REF_VOLTAGE2                   0
 
 /* Channel no. where the VBG voltage is connected.*/
 #define VBG_CHANNEL    (0u)
 
+/* Channel no. where the opamp output is connected.*/
+#define OPAMP_CHANNEL  (1u)
+
+/* Channel no. where the output of the second opamp is connected. Set it in
+ * DEFINES when the design routes oa1 to another SAR channel.
+ */
+#ifndef OPAMP1_CHANNEL
+#define OPAMP1_CHANNEL (2u)
+#endif
+
+/* Bit of a test point in a selftest_run() mask */
+#define SELFTEST_MASK(id)                  (1uL << (uint32_t)(id))
+
+/* Test point of the ADC and opamp tests for a reference point */
+#define SELFTEST_ADC_ID(ref)               ((selftest_id_t)((uint32_t)SELFTEST_ID_ADC_VDD_1_3 + (uint32_t)(ref)))
+#define SELFTEST_OPAMP_ID(ref)             ((selftest_id_t)((uint32_t)SELFTEST_ID_OPAMP_VDD_1_3 + (uint32_t)(ref)))
+#define SELFTEST_OPAMP1_ID(ref)            ((selftest_id_t)((uint32_t)SELFTEST_ID_OPAMP1_VDD_1_3 + (uint32_t)(ref)))
+
+/* Test points of comparator_test() and of opamp_test() for a reference point,
+ * covering every instance that is built
+ */
+#if SELFTEST_COMPARATOR1_ENABLE
+#define SELFTEST_COMPARATOR1_MASK          (SELFTEST_MASK(SELFTEST_ID_COMP1_LOW) | SELFTEST_MASK(SELFTEST_ID_COMP1_HIGH))
+#else
+#define SELFTEST_COMPARATOR1_MASK          (0uL)
+#endif
+#define SELFTEST_COMPARATOR_MASK           (SELFTEST_MASK(SELFTEST_ID_COMP_LOW) | \
+                                            SELFTEST_MASK(SELFTEST_ID_COMP_HIGH) | SELFTEST_COMPARATOR1_MASK)
+
+#if SELFTEST_OPAMP1_ENABLE
+#define SELFTEST_OPAMP1_MASK(ref)          (SELFTEST_MASK(SELFTEST_OPAMP1_ID(ref)))
+#else
+#define SELFTEST_OPAMP1_MASK(ref)          (0uL)
+#endif
+#define SELFTEST_OPAMP_MASK(ref)           (SELFTEST_MASK(SELFTEST_OPAMP_ID(ref)) | SELFTEST_OPAMP1_MASK(ref))
+
+/* Declarative list of the test points built for the target, one group per
+ * peripheral enabled in selftest_config.h and one set of entries per instance
+ * of the peripheral. Each entry is
+ * X(name, periph, instance, channel, vplus_bus, expected, accuracy, prompt, pass_msg, fail_msg)
+ * and expands to SELFTEST_ID_<name> and its selftest_table entry.
+ */
+#if SELFTEST_ADC_ENABLE
+#define SELFTEST_LIST_ADC(X) \
+    X(ADC_VDD_1_3, ADC, 0u,  VBG_CHANNEL, HSIOM_SEL_GPIO, \
+      ANALOG_ADC_SAR_RESULT1, SELFTEST_ADC_ACCURACY, \
+      "Ensure that a (1/3 VDD) signal is connected to ADC channel 0.\r\n", \
+      "SUCCESS: ADC SelfTest passed for 1/3 VDD signal.\r\n", \
+      "Error: ADC SelfTest failed for 1/3 VDD signal.\r\n") \
+    X(ADC_VDD_2_3, ADC, 0u,  VBG_CHANNEL, HSIOM_SEL_GPIO, \
+      ANALOG_ADC_SAR_RESULT2, SELFTEST_ADC_ACCURACY, \
+      "Ensure that a (2/3 VDD) signal is connected to ADC channel 0.\r\n", \
+      "SUCCESS: ADC SelfTest passed for 2/3 VDD signal.\r\n", \
+      "Error: ADC SelfTest failed for 2/3 VDD signal.\r\n")
+#else
+#define SELFTEST_LIST_ADC(X)
+#endif
+
+#if SELFTEST_COMPARATOR_ENABLE
+#define SELFTEST_LIST_COMPARATOR(X) \
+    X(COMP_LOW, COMPARATOR, 0u,  0u, HSIOM_SEL_AMUXA, ANALOG_COMP_RESULT2, 0, \
+      "Apply lower voltage to positive input (CYBSP_DUT_LPCOMP_VPLUS_PIN).\r\n", \
+      "SUCCESS: LPCOMP lower voltage test\r\n", \
+      "Error: LPCOMP lower voltage test fail\r\n") \
+    X(COMP_HIGH, COMPARATOR, 0u,  0u, HSIOM_SEL_AMUXB, ANALOG_COMP_RESULT1, 0, \
+      NULL, \
+      "SUCCESS: LPCOMP higher voltage test\r\n", \
+      "Error: LPCOMP higher voltage test fail\r\n")
+#else
+#define SELFTEST_LIST_COMPARATOR(X)
+#endif
+
+#if SELFTEST_COMPARATOR1_ENABLE
+#define SELFTEST_LIST_COMPARATOR1(X) \
+    X(COMP1_LOW, COMPARATOR, 1u,  0u, HSIOM_SEL_AMUXA, ANALOG_COMP_RESULT2, 0, \
+      "Apply lower voltage to positive input (CYBSP_DUT_LPCOMP1_VPLUS_PIN).\r\n", \
+      "SUCCESS: LPCOMP1 lower voltage test\r\n", \
+      "Error: LPCOMP1 lower voltage test fail\r\n") \
+    X(COMP1_HIGH, COMPARATOR, 1u,  0u, HSIOM_SEL_AMUXB, ANALOG_COMP_RESULT1, 0, \
+      NULL, \
+      "SUCCESS: LPCOMP1 higher voltage test\r\n", \
+      "Error: LPCOMP1 higher voltage test fail\r\n")
+#else
+#define SELFTEST_LIST_COMPARATOR1(X)
+#endif
+
+#if SELFTEST_OPAMP_ENABLE
+#define SELFTEST_LIST_OPAMP(X) \
+    X(OPAMP_VDD_1_3, OPAMP, 0u, OPAMP_CHANNEL, HSIOM_SEL_GPIO, \
+      ANALOG_OPAMP_SAR_RESULT1, SELFTEST_OPAMP_ACCURACY, \
+      "Ensure that a (1/3 VDD) signal is connected to opamp channel.\r\n", \
+      "SUCCESS: OPAMP test passed for 1/3 VDD signal.\r\n", \
+      "Error: OPAMP test failed for 1/3 VDD signal.\r\n") \
+    X(OPAMP_VDD_2_3, OPAMP, 0u, OPAMP_CHANNEL, HSIOM_SEL_GPIO, \
+      ANALOG_OPAMP_SAR_RESULT2, SELFTEST_OPAMP_ACCURACY, \
+      "Ensure that a (2/3 VDD) signal is connected to opamp channel.\r\n", \
+      "SUCCESS: OPAMP test passed for 2/3 VDD signal.\r\n", \
+      "Error: OPAMP test failed for 2/3 VDD signal.\r\n")
+#else
+#define SELFTEST_LIST_OPAMP(X)
+#endif
+
+#if SELFTEST_OPAMP1_ENABLE
+#define SELFTEST_LIST_OPAMP1(X) \
+    X(OPAMP1_VDD_1_3, OPAMP, 1u, OPAMP1_CHANNEL, HSIOM_SEL_GPIO, \
+      ANALOG_OPAMP_SAR_RESULT1, SELFTEST_OPAMP_ACCURACY, \
+      "Ensure that a (1/3 VDD) signal is connected to opamp1 channel.\r\n", \
+      "SUCCESS: OPAMP1 test passed for 1/3 VDD signal.\r\n", \
+      "Error: OPAMP1 test failed for 1/3 VDD signal.\r\n") \
+    X(OPAMP1_VDD_2_3, OPAMP, 1u, OPAMP1_CHANNEL, HSIOM_SEL_GPIO, \
+      ANALOG_OPAMP_SAR_RESULT2, SELFTEST_OPAMP_ACCURACY, \
+      "Ensure that a (2/3 VDD) signal is connected to opamp1 channel.\r\n", \
+      "SUCCESS: OPAMP1 test passed for 2/3 VDD signal.\r\n", \
+      "Error: OPAMP1 test failed for 2/3 VDD signal.\r\n")
+#else
+#define SELFTEST_LIST_OPAMP1(X)
+#endif
+
+#define SELFTEST_LIST(X) \
+    SELFTEST_LIST_ADC(X) \
+    SELFTEST_LIST_COMPARATOR(X) \
+    SELFTEST_LIST_COMPARATOR1(X) \
+    SELFTEST_LIST_OPAMP(X) \
+    SELFTEST_LIST_OPAMP1(X)
+
+#define SELFTEST_ID_ENUM(name, ...)        SELFTEST_ID_##name,
+#define SELFTEST_ID_NAME(name, ...)        #name,
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Peripheral checked by a test point */
+typedef enum
+{
+    SELFTEST_PERIPH_ADC,
+    SELFTEST_PERIPH_COMPARATOR,
+    SELFTEST_PERIPH_OPAMP
+} selftest_periph_t;
+
+/* Test points of the descriptor table, in SELFTEST_LIST() order */
+typedef enum
+{
+    SELFTEST_LIST(SELFTEST_ID_ENUM)
+    SELFTEST_ID_COUNT
+} selftest_id_t;
+
+/* Reference voltage applied to the ADC and opamp inputs */
+typedef enum
+{
+    SELFTEST_REF_VDD_1_3,
+    SELFTEST_REF_VDD_2_3
+} selftest_ref_t;
+
+/* Description of one test point */
+typedef struct
+{
+    selftest_periph_t periph;   /* Peripheral under test */
+    uint32_t instance;          /* LPCOMP channel or CTB opamp, 0 = CYBSP_DUT_* */
+    uint32_t channel;           /* SAR channel of the ADC and opamp tests */
+    en_hsiom_sel_t vplus_bus;   /* AMUX bus of the comparator positive input */
+    int16_t expected;           /* Expected SAR result or comparator output */
+    int16_t accuracy;           /* Allowed deviation from expected in counts */
+    const char *prompt;         /* Operator prompt, NULL for none */
+    const char *pass_msg;
+    const char *fail_msg;
+} selftest_descriptor_t;
+
+/* Peripheral initialization counters */
+typedef struct
+{
+    uint32_t performed;
+    uint32_t skipped;
+} selftest_init_stats_t;
+
+/* Result counters of one test point */
+typedef struct
+{
+    uint32_t runs;
+    uint32_t failures;
+    uint32_t median_in_window;  /* Failures whose median re-measure was in the window */
+} selftest_result_stats_t;
+
+/* Progress of a non-blocking ADC or opamp measurement, a window check of a
+ * single conversion and not an STL check
+ */
+typedef enum
+{
+    SELFTEST_ASYNC_IDLE,
+    SELFTEST_ASYNC_BUSY,
+    SELFTEST_ASYNC_PASS,
+    SELFTEST_ASYNC_FAIL
+} selftest_async_status_t;
+
+/* One channel of a multi-channel ADC scan test */
+typedef struct
+{
+    selftest_id_t id;           /* Test point the result is recorded for */
+    uint32_t channel;
+    int16_t expected;
+    int16_t accuracy;
+} adc_scan_channel_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern const selftest_descriptor_t selftest_table[SELFTEST_ID_COUNT];
+extern const char *const selftest_names[SELFTEST_ID_COUNT];
+
 /*******************************************************************************
 * Function Prototypes
 *******************************************************************************/
+uint32_t selftest_run(uint32_t mask);
+uint32_t selftest_get_run_all_mask(void);
+void selftest_enable_blocks(uint32_t mask);
+void selftest_set_reference(selftest_ref_t ref);
+selftest_ref_t selftest_get_reference(void);
+void selftest_invalidate_contexts(void);
+const selftest_init_stats_t *selftest_get_init_stats(void);
+void selftest_print_init_stats(void);
+const selftest_result_stats_t *selftest_get_result_stats(void);
+void selftest_set_quiet(bool quiet);
+void selftest_print_stack_usage(void);
+#if SELFTEST_ADC_ENABLE
 void adc_test(void);
+bool adc_test_start(void);
+#endif
+#if SELFTEST_COMPARATOR_ENABLE
 void comparator_test(void);
+#endif
+#if SELFTEST_OPAMP_ENABLE
 void opamp_test(void);
+bool opamp_test_start(void);
+#endif
+#if SELFTEST_SAR_TESTS_ENABLE
+selftest_async_status_t selftest_async_poll(void);
+uint32_t adc_scan_test(const adc_scan_channel_t *channels, uint32_t count);
+void adc_multi_channel_test(void);
+#endif
+void selftest_set_measure_mode(const selftest_measure_config_t *config);
 
 #endif /* SELF_TEST_H_ */
 
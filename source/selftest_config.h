@@ -0,0 +1,153 @@
+/******************************************************************************
+* File Name:   selftest_config.h
+*
+* Description: This file selects the self test groups built for the target.
+*              A group is built when the BSP design of the kit routes its
+*              peripheral, so unused tests, strings and PDL calls are left out.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SELFTEST_CONFIG_H_
+#define SELFTEST_CONFIG_H_
+
+#include "cybsp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The comparator and opamp groups are built when the design routes the
+ * peripheral. Define a group to 0 (e.g. in DEFINES of the Makefile) to leave
+ * it out anyway.
+ */
+#ifndef SELFTEST_ADC_ENABLE
+#define SELFTEST_ADC_ENABLE                1
+#endif
+
+#ifndef SELFTEST_COMPARATOR_ENABLE
+#if defined(CYBSP_DUT_LPCOMP_HW)
+#define SELFTEST_COMPARATOR_ENABLE         1
+#else
+#define SELFTEST_COMPARATOR_ENABLE         0
+#endif
+#endif
+
+#ifndef SELFTEST_OPAMP_ENABLE
+#if defined(CYBSP_DUT_OPAMP_HW)
+#define SELFTEST_OPAMP_ENABLE              1
+#else
+#define SELFTEST_OPAMP_ENABLE              0
+#endif
+#endif
+
+/* Further instances covered by the comparator and opamp groups: a second
+ * LPCOMP channel routed as CYBSP_DUT_LPCOMP1, and the other opamp of the CTB
+ * of CYBSP_DUT_OPAMP routed as CYBSP_DUT_OPAMP1. None of the shipped designs
+ * defines these names, so both instances are hooks for a custom design.
+ */
+#ifndef SELFTEST_COMPARATOR1_ENABLE
+#if SELFTEST_COMPARATOR_ENABLE && defined(CYBSP_DUT_LPCOMP1_HW)
+#define SELFTEST_COMPARATOR1_ENABLE        1
+#else
+#define SELFTEST_COMPARATOR1_ENABLE        0
+#endif
+#endif
+
+#ifndef SELFTEST_OPAMP1_ENABLE
+#if SELFTEST_OPAMP_ENABLE && defined(CYBSP_DUT_OPAMP1_HW)
+#define SELFTEST_OPAMP1_ENABLE             1
+#else
+#define SELFTEST_OPAMP1_ENABLE             0
+#endif
+#endif
+
+/* Opamp of the CTB (0 for oa0, 1 for oa1) that CYBSP_DUT_OPAMP and
+ * CYBSP_DUT_OPAMP1 occupy in the design. The shipped designs place
+ * CYBSP_DUT_OPAMP on pass[0].ctb[0].oa[1].
+ */
+#ifndef SELFTEST_OPAMP_OA
+#define SELFTEST_OPAMP_OA                  1
+#endif
+
+#ifndef SELFTEST_OPAMP1_OA
+#define SELFTEST_OPAMP1_OA                 (1 - SELFTEST_OPAMP_OA)
+#endif
+
+#if (SELFTEST_OPAMP_OA != 0) && (SELFTEST_OPAMP_OA != 1)
+#error "SELFTEST_OPAMP_OA must be 0 (oa0) or 1 (oa1)"
+#endif
+#if SELFTEST_OPAMP1_ENABLE && (SELFTEST_OPAMP1_OA == SELFTEST_OPAMP_OA)
+#error "CYBSP_DUT_OPAMP and CYBSP_DUT_OPAMP1 must occupy different opamps of the CTB"
+#endif
+
+/* Accuracy windows of the ADC and opamp test points in SAR counts. They
+ * default to the STL values and can be overridden per build with thresholds
+ * characterized for the board.
+ */
+#ifndef SELFTEST_ADC_ACCURACY
+#define SELFTEST_ADC_ACCURACY              (ANALOG_ADC_ACURACCY)
+#endif
+
+#ifndef SELFTEST_OPAMP_ACCURACY
+#define SELFTEST_OPAMP_ACCURACY            (ANALOG_OPAMP_ACURACCY)
+#endif
+
+/* The ADC and opamp tests both convert their signal with the SAR */
+#define SELFTEST_SAR_TESTS_ENABLE          (SELFTEST_ADC_ENABLE || SELFTEST_OPAMP_ENABLE)
+
+/* The SAR is always required: it converts the ADC and opamp test signals and
+ * its sequencer and AMUX routing are saved around every test run.
+ */
+#if !defined(CYBSP_DUT_SAR_ADC_HW)
+#error "The self tests require the CYBSP_DUT_SAR_ADC block in the design"
+#endif
+
+#if !(SELFTEST_ADC_ENABLE || SELFTEST_COMPARATOR_ENABLE || SELFTEST_OPAMP_ENABLE)
+#error "No self test group is enabled for this target"
+#endif
+
+#if (SELFTEST_COMPARATOR1_ENABLE && !SELFTEST_COMPARATOR_ENABLE) || \
+    (SELFTEST_OPAMP1_ENABLE && !SELFTEST_OPAMP_ENABLE)
+#error "A second instance requires its self test group to be enabled"
+#endif
+
+#endif /* SELFTEST_CONFIG_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,374 @@
+/******************************************************************************
+* File Name:   selftest_drift.c
+*
+* Description: This file keeps integer running statistics (Welford mean and
+*              variance, EWMA, min/max) of the measured counts of the ADC and
+*              opamp test points and flags a drift toward the edge of the
+*              accuracy window before the pass/fail check fails.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+#include <stdio.h>
+#include "selftest_drift.h"
+#include "uart_tx.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SELFTEST_DRIFT_ONE                 (1L << SELFTEST_DRIFT_FRAC_BITS)
+#define SELFTEST_DRIFT_EWMA_DIV            (1L << SELFTEST_DRIFT_EWMA_SHIFT)
+#define SELFTEST_DRIFT_MEAN_ONE            (1LL << SELFTEST_DRIFT_MEAN_FRAC_BITS)
+#define SELFTEST_DRIFT_MEAN_SCALE          (1LL << (SELFTEST_DRIFT_MEAN_FRAC_BITS - SELFTEST_DRIFT_FRAC_BITS))
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static selftest_drift_stats_t selftest_drift_stats[SELFTEST_ID_COUNT];
+static uint32_t selftest_drift_warn_percent = SELFTEST_DRIFT_WARN_PERCENT;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool selftest_drift_beyond_threshold(selftest_id_t id, int32_t ewma);
+static int64_t selftest_drift_div_round(int64_t numerator, int64_t denominator);
+static void selftest_drift_format(char *text, uint32_t size, int32_t value);
+
+/*******************************************************************************
+* Function Name: selftest_drift_beyond_threshold
+********************************************************************************
+* Summary:
+* Checks whether an EWMA deviates from the expected result of the test point
+* by more than the early warning share of its accuracy window.
+*
+* Parameters:
+*  id   - test point
+*  ewma - EWMA with SELFTEST_DRIFT_FRAC_BITS fraction
+*
+* Return :
+*  bool - true if the warning threshold is exceeded
+*
+*******************************************************************************/
+static bool selftest_drift_beyond_threshold(selftest_id_t id, int32_t ewma)
+{
+    const selftest_descriptor_t *entry = &selftest_table[id];
+    int32_t deviation = ewma - ((int32_t)entry->expected * SELFTEST_DRIFT_ONE);
+    int32_t threshold = ((int32_t)entry->accuracy * SELFTEST_DRIFT_ONE *
+            (int32_t)selftest_drift_warn_percent) / 100;
+
+    return ((deviation > threshold) || (deviation < -threshold));
+}
+
+/*******************************************************************************
+* Function Name: selftest_drift_div_round
+********************************************************************************
+* Summary:
+* Divides and rounds to the nearest integer, halves away from zero.
+*
+* Parameters:
+*  numerator   - dividend
+*  denominator - divisor, greater than 0
+*
+* Return :
+*  int64_t - rounded quotient
+*
+*******************************************************************************/
+static int64_t selftest_drift_div_round(int64_t numerator, int64_t denominator)
+{
+    return (numerator >= 0) ? ((numerator + (denominator / 2)) / denominator) :
+            -(((-numerator) + (denominator / 2)) / denominator);
+}
+
+/*******************************************************************************
+* Function Name: selftest_drift_add
+********************************************************************************
+* Summary:
+* Adds the measured counts of an ADC or opamp test point to its statistics in
+* constant time and memory. Comparator results are binary and ignored.
+*
+* Parameters:
+*  id       - test point
+*  measured - measured SAR counts
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_drift_add(selftest_id_t id, int16_t measured)
+{
+    selftest_drift_stats_t *stats = &selftest_drift_stats[id];
+    int32_t sample = (int32_t)measured * SELFTEST_DRIFT_ONE;
+    int64_t sample_fine = (int64_t)measured * SELFTEST_DRIFT_MEAN_ONE;
+    int64_t delta;
+
+    if (SELFTEST_PERIPH_COMPARATOR == selftest_table[id].periph)
+    {
+        return;
+    }
+
+    if (0u == stats->count)
+    {
+        stats->mean_fine = sample_fine;
+        stats->m2 = 0;
+        stats->ewma = sample;
+        stats->min = measured;
+        stats->max = measured;
+        stats->count = 1u;
+    }
+    else
+    {
+        if (stats->count >= SELFTEST_DRIFT_MAX_COUNT)
+        {
+            stats->count /= 2u;
+            stats->m2 /= 2;
+        }
+        stats->count++;
+        delta = sample_fine - stats->mean_fine;
+        stats->mean_fine += selftest_drift_div_round(delta, (int64_t)stats->count);
+        stats->m2 += (delta * (sample_fine - stats->mean_fine)) /
+                (SELFTEST_DRIFT_MEAN_SCALE * SELFTEST_DRIFT_MEAN_SCALE);
+        stats->ewma += (sample - stats->ewma) / SELFTEST_DRIFT_EWMA_DIV;
+
+        if (measured < stats->min)
+        {
+            stats->min = measured;
+        }
+        if (measured > stats->max)
+        {
+            stats->max = measured;
+        }
+    }
+
+    stats->mean = (int32_t)selftest_drift_div_round(stats->mean_fine, SELFTEST_DRIFT_MEAN_SCALE);
+    stats->warning = selftest_drift_beyond_threshold(id, stats->ewma);
+}
+
+/*******************************************************************************
+* Function Name: selftest_drift_get
+********************************************************************************
+* Summary:
+* Returns the running statistics of a test point.
+*
+* Parameters:
+*  id - test point
+*
+* Return :
+*  const selftest_drift_stats_t* - statistics, count 0 if no sample was added
+*
+*******************************************************************************/
+const selftest_drift_stats_t *selftest_drift_get(selftest_id_t id)
+{
+    return &selftest_drift_stats[id];
+}
+
+/*******************************************************************************
+* Function Name: selftest_drift_get_variance
+********************************************************************************
+* Summary:
+* Returns the sample variance of a test point in counts squared.
+*
+* Parameters:
+*  id - test point
+*
+* Return :
+*  uint32_t - variance with SELFTEST_DRIFT_FRAC_BITS fraction, saturated at
+*  UINT32_MAX, 0 for less than two samples
+*
+*******************************************************************************/
+uint32_t selftest_drift_get_variance(selftest_id_t id)
+{
+    const selftest_drift_stats_t *stats = &selftest_drift_stats[id];
+    int64_t variance;
+
+    if (stats->count < 2u)
+    {
+        return 0u;
+    }
+    variance = (stats->m2 / (int64_t)(stats->count - 1u)) / SELFTEST_DRIFT_ONE;
+
+    return (variance > (int64_t)UINT32_MAX) ? UINT32_MAX : (uint32_t)variance;
+}
+
+/*******************************************************************************
+* Function Name: selftest_drift_get_warnings
+********************************************************************************
+* Summary:
+* Status query for the early warnings of all test points.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  uint32_t - bitmap of SELFTEST_MASK(id) values of the drifting test points
+*
+*******************************************************************************/
+uint32_t selftest_drift_get_warnings(void)
+{
+    uint32_t warnings = 0u;
+    uint32_t id;
+
+    for (id = 0u; id < (uint32_t)SELFTEST_ID_COUNT; id++)
+    {
+        if (selftest_drift_stats[id].warning)
+        {
+            warnings |= SELFTEST_MASK(id);
+        }
+    }
+
+    return warnings;
+}
+
+/*******************************************************************************
+* Function Name: selftest_drift_set_warn_percent
+********************************************************************************
+* Summary:
+* Sets the early warning threshold and re-evaluates the warnings.
+*
+* Parameters:
+*  percent - share of the accuracy window, below 100 to warn before a failure
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_drift_set_warn_percent(uint32_t percent)
+{
+    uint32_t id;
+
+    selftest_drift_warn_percent = percent;
+    for (id = 0u; id < (uint32_t)SELFTEST_ID_COUNT; id++)
+    {
+        if (0u != selftest_drift_stats[id].count)
+        {
+            selftest_drift_stats[id].warning =
+                    selftest_drift_beyond_threshold((selftest_id_t)id, selftest_drift_stats[id].ewma);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: selftest_drift_reset
+********************************************************************************
+* Summary:
+* Clears the statistics of all test points, e.g. after a recalibration.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_drift_reset(void)
+{
+    uint32_t id;
+
+    for (id = 0u; id < (uint32_t)SELFTEST_ID_COUNT; id++)
+    {
+        selftest_drift_stats[id].count = 0u;
+        selftest_drift_stats[id].warning = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: selftest_drift_format
+********************************************************************************
+* Summary:
+* Formats a fixed point value with two decimals.
+*
+* Parameters:
+*  text  - destination
+*  size  - destination size
+*  value - value with SELFTEST_DRIFT_FRAC_BITS fraction
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void selftest_drift_format(char *text, uint32_t size, int32_t value)
+{
+    uint32_t magnitude = (value < 0) ? (uint32_t)(-value) : (uint32_t)value;
+    uint32_t hundredths = ((magnitude * 100u) + ((uint32_t)SELFTEST_DRIFT_ONE / 2u)) >>
+            SELFTEST_DRIFT_FRAC_BITS;
+
+    (void)snprintf(text, size, "%s%lu.%02lu", (value < 0) ? "-" : "",
+            (unsigned long)(hundredths / 100u), (unsigned long)(hundredths % 100u));
+}
+
+/*******************************************************************************
+* Function Name: selftest_drift_print
+********************************************************************************
+* Summary:
+* Prints the statistics of every test point with samples, in counts.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_drift_print(void)
+{
+    char line[112];
+    char mean[16];
+    char ewma[16];
+    char variance[16];
+    const selftest_drift_stats_t *stats;
+    uint32_t id;
+
+    for (id = 0u; id < (uint32_t)SELFTEST_ID_COUNT; id++)
+    {
+        stats = &selftest_drift_stats[id];
+        if (0u == stats->count)
+        {
+            continue;
+        }
+
+        selftest_drift_format(mean, sizeof(mean), stats->mean);
+        selftest_drift_format(ewma, sizeof(ewma), stats->ewma);
+        selftest_drift_format(variance, sizeof(variance),
+                (int32_t)selftest_drift_get_variance((selftest_id_t)id));
+        (void)snprintf(line, sizeof(line),
+                "%-14s n=%lu mean=%s var=%s ewma=%s min=%d max=%d expected=%d%s\r\n",
+                selftest_names[id], (unsigned long)stats->count, mean, variance, ewma,
+                stats->min, stats->max, selftest_table[id].expected,
+                stats->warning ? " WARNING" : "");
+        uart_tx_puts(line);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,114 @@
+/******************************************************************************
+* File Name:   selftest_drift.h
+*
+* Description: This file is the public interface of selftest_drift.c source
+*              file.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SELFTEST_DRIFT_H_
+#define SELFTEST_DRIFT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "self_test.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Early warning when the EWMA deviates from the expected result by more than
+ * this share of the accuracy window, in percent
+ */
+#ifndef SELFTEST_DRIFT_WARN_PERCENT
+#define SELFTEST_DRIFT_WARN_PERCENT        (75u)
+#endif
+
+/* Weight of a new sample in the EWMA is 1 / 2^SELFTEST_DRIFT_EWMA_SHIFT */
+#ifndef SELFTEST_DRIFT_EWMA_SHIFT
+#define SELFTEST_DRIFT_EWMA_SHIFT          (3u)
+#endif
+
+/* Sample count at which count and sum of squares are halved, so old samples
+ * fade out and the sum of squares cannot overflow
+ */
+#ifndef SELFTEST_DRIFT_MAX_COUNT
+#define SELFTEST_DRIFT_MAX_COUNT           (4096u)
+#endif
+
+/* Fractional bits of the mean and EWMA, twice as many for the sum of squares */
+#define SELFTEST_DRIFT_FRAC_BITS           (8u)
+
+/* Fractional bits of the running mean the Welford update works on. With
+ * SELFTEST_DRIFT_FRAC_BITS only, delta / count truncates to 0 once count
+ * exceeds 256 times the deviation, and the mean stops following the samples.
+ */
+#define SELFTEST_DRIFT_MEAN_FRAC_BITS      (16u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Running statistics of the measured counts of one test point */
+typedef struct
+{
+    uint32_t count;     /* Samples in the mean, saturates near SELFTEST_DRIFT_MAX_COUNT */
+    int32_t mean;       /* Welford mean, SELFTEST_DRIFT_FRAC_BITS fraction, rounded */
+    int64_t mean_fine;  /* Welford mean, SELFTEST_DRIFT_MEAN_FRAC_BITS fraction */
+    int64_t m2;         /* Welford sum of squared deviations, 2x fraction */
+    int32_t ewma;       /* Exponentially weighted mean, SELFTEST_DRIFT_FRAC_BITS fraction */
+    int16_t min;
+    int16_t max;
+    bool warning;       /* EWMA beyond the early warning threshold */
+} selftest_drift_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void selftest_drift_add(selftest_id_t id, int16_t measured);
+const selftest_drift_stats_t *selftest_drift_get(selftest_id_t id);
+uint32_t selftest_drift_get_variance(selftest_id_t id);
+uint32_t selftest_drift_get_warnings(void);
+void selftest_drift_set_warn_percent(uint32_t percent);
+void selftest_drift_reset(void);
+void selftest_drift_print(void);
+
+#endif /* SELFTEST_DRIFT_H_ */
+
+/* [] END OF FILE */
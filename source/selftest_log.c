@@ -0,0 +1,486 @@
+/******************************************************************************
+* File Name:   selftest_log.c
+*
+* Description: This file keeps self test results as compact binary records in
+*              a RAM ring buffer, optionally mirrored to flash, and streams
+*              them over the UART in one block.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+#include <stdbool.h>
+#include "cy_pdl.h"
+#include "selftest_log.h"
+#include "timebase.h"
+#include "uart_tx.h"
+#include "crc16.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SELFTEST_LOG_INDEX_MASK            (SELFTEST_LOG_DEPTH - 1u)
+
+#if SELFTEST_LOG_FLASH_MIRROR
+/* Records of one flash row, after the 8-byte row header */
+#define SELFTEST_LOG_RECORDS_PER_ROW \
+    ((CY_FLASH_SIZEOF_ROW - 8u) / sizeof(selftest_log_record_t))
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+#if SELFTEST_LOG_FLASH_MIRROR
+/* One row of the flash mirror. The row sequence number increments per row
+ * written, so the newest row, and with it the next row to write, is found
+ * again after a reset.
+ */
+typedef struct
+{
+    uint32_t magic;         /* SELFTEST_LOG_FLASH_MAGIC */
+    uint16_t row_sequence;  /* Incremented per row written, wraps at 16 bits */
+    uint16_t crc;           /* CRC-16/CCITT of row_sequence and the records */
+    selftest_log_record_t records[SELFTEST_LOG_RECORDS_PER_ROW];
+} selftest_log_flash_row_t;
+
+/* Row buffer as written with Cy_Flash_WriteRow() */
+typedef union
+{
+    selftest_log_flash_row_t row;
+    uint32_t words[CY_FLASH_SIZEOF_ROW / sizeof(uint32_t)];
+} selftest_log_row_buffer_t;
+#endif
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static selftest_log_record_t selftest_log_records[SELFTEST_LOG_DEPTH];
+
+/* Total number of records held; the newest is at (selftest_log_total - 1) */
+static uint32_t selftest_log_total = 0u;
+
+/* Sequence number of the next record, continued from the flash mirror */
+static uint16_t selftest_log_sequence = 0u;
+
+#if SELFTEST_LOG_FLASH_MIRROR
+/* Reserved flash region, filled row by row as a circular buffer */
+CY_SECTION(".cy_em_eeprom") CY_ALIGN(CY_FLASH_SIZEOF_ROW)
+static const uint8_t selftest_log_flash[SELFTEST_LOG_FLASH_ROWS * CY_FLASH_SIZEOF_ROW] = { 0u };
+
+/* Row being filled and completed row waiting for selftest_log_process() */
+static selftest_log_row_buffer_t selftest_log_row_buffer[2];
+static uint32_t selftest_log_row_fill = 0u;
+static uint32_t selftest_log_row_active = 0u;
+static volatile bool selftest_log_row_pending = false;
+static uint32_t selftest_log_row_next = 0u;
+static uint16_t selftest_log_row_sequence = 0u;
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static selftest_log_record_t *selftest_log_append(void);
+#if SELFTEST_LOG_FLASH_MIRROR
+static uint16_t selftest_log_row_crc(const volatile selftest_log_flash_row_t *row);
+static const volatile selftest_log_flash_row_t *selftest_log_flash_row(uint32_t row);
+static bool selftest_log_row_valid(const volatile selftest_log_flash_row_t *row);
+#endif
+
+/*******************************************************************************
+* Function Name: selftest_log_append
+********************************************************************************
+* Summary:
+* Takes the next slot of the RAM ring, overwriting the oldest record when the
+* buffer is full.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  selftest_log_record_t * - slot of the new record
+*
+*******************************************************************************/
+static selftest_log_record_t *selftest_log_append(void)
+{
+    selftest_log_record_t *record = &selftest_log_records[selftest_log_total & SELFTEST_LOG_INDEX_MASK];
+
+    selftest_log_total++;
+
+    return record;
+}
+
+#if SELFTEST_LOG_FLASH_MIRROR
+/*******************************************************************************
+* Function Name: selftest_log_row_crc
+********************************************************************************
+* Summary:
+* Calculates the CRC of a flash row over its sequence number and records.
+* The row is read byte by byte through a volatile pointer, see
+* selftest_log_flash_row().
+*
+* Parameters:
+*  row - flash row or row buffer
+*
+* Return :
+*  uint16_t - CRC-16/CCITT
+*
+*******************************************************************************/
+static uint16_t selftest_log_row_crc(const volatile selftest_log_flash_row_t *row)
+{
+    const volatile uint8_t *data = (const volatile uint8_t *)&row->row_sequence;
+    uint32_t size = sizeof(row->row_sequence);
+    uint16_t crc = CRC16_CCITT_INIT;
+    uint8_t byte;
+    uint32_t idx;
+
+    for (idx = 0u; idx < size; idx++)
+    {
+        byte = data[idx];
+        crc = crc16_ccitt(crc, &byte, 1u);
+    }
+
+    data = (const volatile uint8_t *)row->records;
+    size = SELFTEST_LOG_RECORDS_PER_ROW * sizeof(selftest_log_record_t);
+    for (idx = 0u; idx < size; idx++)
+    {
+        byte = data[idx];
+        crc = crc16_ccitt(crc, &byte, 1u);
+    }
+
+    return crc;
+}
+
+/*******************************************************************************
+* Function Name: selftest_log_flash_row
+********************************************************************************
+* Summary:
+* Returns a row of the reserved flash region. The region is a const array
+* initialized to zero and only changed by Cy_Flash_WriteRow(), so it is read
+* through a volatile pointer: otherwise the compiler may replace the reads by
+* the zero initializer and the mirror is never found at startup.
+*
+* Parameters:
+*  row - row index, below SELFTEST_LOG_FLASH_ROWS
+*
+* Return :
+*  const volatile selftest_log_flash_row_t * - row content
+*
+*******************************************************************************/
+static const volatile selftest_log_flash_row_t *selftest_log_flash_row(uint32_t row)
+{
+    return (const volatile selftest_log_flash_row_t *)&selftest_log_flash[row * CY_FLASH_SIZEOF_ROW];
+}
+
+/*******************************************************************************
+* Function Name: selftest_log_row_valid
+********************************************************************************
+* Summary:
+* Checks the magic number and CRC of a flash row. Erased rows and rows whose
+* write was cut short by a reset are invalid.
+*
+* Parameters:
+*  row - flash row
+*
+* Return :
+*  bool - true if the row holds records
+*
+*******************************************************************************/
+static bool selftest_log_row_valid(const volatile selftest_log_flash_row_t *row)
+{
+    return (SELFTEST_LOG_FLASH_MAGIC == row->magic) && (selftest_log_row_crc(row) == row->crc);
+}
+#endif
+
+/*******************************************************************************
+* Function Name: selftest_log_init
+********************************************************************************
+* Summary:
+* With the flash mirror enabled, finds the newest valid row of the reserved
+* flash region, continues writing after it, and restores the records of the
+* valid rows into the RAM ring, oldest first, so that they are included in
+* the dump. Records keep the timestamps of the boot that wrote them, and the
+* sequence numbers continue from the newest one. Records of a row that was
+* not complete at the reset are lost. Call once before the first test.
+* Without the mirror, the log starts empty.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_log_init(void)
+{
+#if SELFTEST_LOG_FLASH_MIRROR
+    const volatile selftest_log_flash_row_t *row;
+    uint32_t newest = SELFTEST_LOG_FLASH_ROWS;
+    uint32_t idx;
+    uint32_t rec;
+#endif
+
+    selftest_log_total = 0u;
+    selftest_log_sequence = 0u;
+
+#if SELFTEST_LOG_FLASH_MIRROR
+    for (idx = 0u; idx < SELFTEST_LOG_FLASH_ROWS; idx++)
+    {
+        row = selftest_log_flash_row(idx);
+        if (selftest_log_row_valid(row) && ((SELFTEST_LOG_FLASH_ROWS == newest) ||
+                ((int16_t)(row->row_sequence - selftest_log_flash_row(newest)->row_sequence) > 0)))
+        {
+            newest = idx;
+        }
+    }
+    selftest_log_row_fill = 0u;
+    selftest_log_row_pending = false;
+    if (SELFTEST_LOG_FLASH_ROWS == newest)
+    {
+        selftest_log_row_next = 0u;
+        selftest_log_row_sequence = 0u;
+        return;
+    }
+    selftest_log_row_next = (newest + 1u) % SELFTEST_LOG_FLASH_ROWS;
+    selftest_log_row_sequence = (uint16_t)(selftest_log_flash_row(newest)->row_sequence + 1u);
+
+    /* Oldest row first: the one after the newest, around the circle */
+    for (idx = 1u; idx <= SELFTEST_LOG_FLASH_ROWS; idx++)
+    {
+        row = selftest_log_flash_row((newest + idx) % SELFTEST_LOG_FLASH_ROWS);
+        if (!selftest_log_row_valid(row) ||
+            ((uint16_t)(selftest_log_row_sequence - row->row_sequence) > SELFTEST_LOG_FLASH_ROWS))
+        {
+            continue;
+        }
+        for (rec = 0u; rec < SELFTEST_LOG_RECORDS_PER_ROW; rec++)
+        {
+            *selftest_log_append() = row->records[rec];
+            selftest_log_sequence = (uint16_t)(row->records[rec].sequence + 1u);
+        }
+    }
+#endif
+}
+
+/*******************************************************************************
+* Function Name: selftest_log_add
+********************************************************************************
+* Summary:
+* Appends a record, overwriting the oldest one when the buffer is full. With
+* the flash mirror enabled, the record is also copied into the row buffer. A
+* completed row is only queued here and written by selftest_log_process(), so
+* the flash write does not stall the tests. If the previous row is still
+* queued, the completed row is discarded.
+*
+* Parameters:
+*  test_id  - selftest_id_t of the test point
+*  status   - OK_STATUS or ERROR_STATUS, may carry SELFTEST_LOG_STATUS_ flags
+*  measured - measured SAR counts or comparator level
+*  expected - expected SAR counts or comparator level
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_log_add(uint8_t test_id, uint8_t status, int16_t measured, int16_t expected)
+{
+    selftest_log_record_t *record = selftest_log_append();
+
+    record->timestamp_ms = timebase_get_ms();
+    record->sequence = selftest_log_sequence;
+    record->test_id = test_id;
+    record->status = status;
+    record->measured = measured;
+    record->expected = expected;
+    selftest_log_sequence++;
+
+#if SELFTEST_LOG_FLASH_MIRROR
+    selftest_log_row_buffer[selftest_log_row_active].row.records[selftest_log_row_fill] = *record;
+    selftest_log_row_fill++;
+    if (selftest_log_row_fill == SELFTEST_LOG_RECORDS_PER_ROW)
+    {
+        selftest_log_row_fill = 0u;
+        if (!selftest_log_row_pending)
+        {
+            selftest_log_row_active ^= 1u;
+            selftest_log_row_pending = true;
+        }
+    }
+#endif
+}
+
+/*******************************************************************************
+* Function Name: selftest_log_process
+********************************************************************************
+* Summary:
+* Writes a completed row of records to the next row of the reserved flash
+* region. Call it from the main loop, outside of test execution, as the CPU
+* stalls while the flash row is written. Does nothing without the flash
+* mirror.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_log_process(void)
+{
+#if SELFTEST_LOG_FLASH_MIRROR
+    selftest_log_flash_row_t *row;
+
+    if (!selftest_log_row_pending)
+    {
+        return;
+    }
+
+    row = &selftest_log_row_buffer[selftest_log_row_active ^ 1u].row;
+    row->magic = SELFTEST_LOG_FLASH_MAGIC;
+    row->row_sequence = selftest_log_row_sequence;
+    row->crc = selftest_log_row_crc(row);
+    if (CY_FLASH_DRV_SUCCESS == Cy_Flash_WriteRow(
+            (uint32_t)selftest_log_flash_row(selftest_log_row_next),
+            selftest_log_row_buffer[selftest_log_row_active ^ 1u].words))
+    {
+        selftest_log_row_next = (selftest_log_row_next + 1u) % SELFTEST_LOG_FLASH_ROWS;
+        selftest_log_row_sequence++;
+    }
+    selftest_log_row_pending = false;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: selftest_log_count
+********************************************************************************
+* Summary:
+* Returns the number of records held in RAM.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  uint32_t - number of records
+*
+*******************************************************************************/
+uint32_t selftest_log_count(void)
+{
+    return (selftest_log_total < SELFTEST_LOG_DEPTH) ? selftest_log_total : SELFTEST_LOG_DEPTH;
+}
+
+/*******************************************************************************
+* Function Name: selftest_log_read
+********************************************************************************
+* Summary:
+* Copies a record, index 0 being the oldest one held.
+*
+* Parameters:
+*  index  - record index, below selftest_log_count()
+*  record - destination
+*
+* Return :
+*  uint32_t - 1 if a record was copied, 0 if the index is out of range
+*
+*******************************************************************************/
+uint32_t selftest_log_read(uint32_t index, selftest_log_record_t *record)
+{
+    uint32_t count = selftest_log_count();
+
+    if (index >= count)
+    {
+        return 0u;
+    }
+    *record = selftest_log_records[(selftest_log_total - count + index) & SELFTEST_LOG_INDEX_MASK];
+
+    return 1u;
+}
+
+/*******************************************************************************
+* Function Name: selftest_log_clear
+********************************************************************************
+* Summary:
+* Discards all records held in RAM. The flash mirror is not erased.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_log_clear(void)
+{
+    selftest_log_total = 0u;
+}
+
+/*******************************************************************************
+* Function Name: selftest_log_dump
+********************************************************************************
+* Summary:
+* Streams a selftest_log_header_t followed by all records, oldest first, as raw
+* binary over the UART. The TX ring buffer blocks instead of dropping bytes
+* while the dump is queued.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_log_dump(void)
+{
+    uart_tx_overflow_policy_t policy = uart_tx_get_overflow_policy();
+    uint32_t count = selftest_log_count();
+    uint32_t first = selftest_log_total - count;
+    uint32_t idx;
+    const selftest_log_header_t header =
+    {
+        .magic = SELFTEST_LOG_MAGIC,
+        .version = SELFTEST_LOG_VERSION,
+        .record_size = (uint8_t)sizeof(selftest_log_record_t),
+        .count = (uint16_t)count,
+    };
+
+    uart_tx_set_overflow_policy(UART_TX_OVERFLOW_BLOCK);
+    uart_tx_write((const uint8_t *)&header, sizeof(header));
+    for (idx = 0u; idx < count; idx++)
+    {
+        uart_tx_write((const uint8_t *)&selftest_log_records[(first + idx) & SELFTEST_LOG_INDEX_MASK],
+                sizeof(selftest_log_record_t));
+    }
+    uart_tx_set_overflow_policy(policy);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,125 @@
+/******************************************************************************
+* File Name:   selftest_log.h
+*
+* Description: This file is the public interface of selftest_log.c source
+*              file.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SELFTEST_LOG_H_
+#define SELFTEST_LOG_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of records kept in RAM. Must be a power of two. */
+#ifndef SELFTEST_LOG_DEPTH
+#define SELFTEST_LOG_DEPTH                 (64u)
+#endif
+
+/* Set to 1 to mirror the records into a reserved flash region */
+#ifndef SELFTEST_LOG_FLASH_MIRROR
+#define SELFTEST_LOG_FLASH_MIRROR          0
+#endif
+
+/* Number of flash rows reserved for the mirror */
+#define SELFTEST_LOG_FLASH_ROWS            (4u)
+
+/* Marks a valid row of the flash mirror, "STLR" */
+#define SELFTEST_LOG_FLASH_MAGIC           (0x524C5453uL)
+
+/* Dump header: magic, format version and record size */
+#define SELFTEST_LOG_MAGIC                 (0x474C5453uL)  /* "STLG" */
+#define SELFTEST_LOG_VERSION               (2u)
+
+/* Set in the status of a failed record whose measured value is the median
+ * re-measurement taken after the STL check
+ */
+#define SELFTEST_LOG_STATUS_MEDIAN         (0x80u)
+
+/* Set in the status of a record of a non-blocking measurement, a window check
+ * of a single conversion instead of an STL check
+ */
+#define SELFTEST_LOG_STATUS_NON_STL        (0x40u)
+
+#if ((SELFTEST_LOG_DEPTH & (SELFTEST_LOG_DEPTH - 1u)) != 0u)
+#error "SELFTEST_LOG_DEPTH must be a power of two"
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* One test result, 12 bytes, little endian, no padding */
+typedef struct
+{
+    uint32_t timestamp_ms;  /* timebase_get_ms() when the test finished */
+    uint16_t sequence;      /* Incremented per record, wraps at 16 bits */
+    uint8_t test_id;        /* selftest_id_t */
+    uint8_t status;         /* OK_STATUS or ERROR_STATUS, SELFTEST_LOG_STATUS_ flags */
+    int16_t measured;       /* SAR counts or comparator output level */
+    int16_t expected;       /* Expected SAR counts or comparator level */
+} selftest_log_record_t;
+
+/* Header sent in front of the records by selftest_log_dump() */
+typedef struct
+{
+    uint32_t magic;         /* SELFTEST_LOG_MAGIC */
+    uint8_t version;        /* SELFTEST_LOG_VERSION */
+    uint8_t record_size;    /* sizeof(selftest_log_record_t) */
+    uint16_t count;         /* Number of records that follow */
+} selftest_log_header_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void selftest_log_init(void);
+void selftest_log_add(uint8_t test_id, uint8_t status, int16_t measured, int16_t expected);
+void selftest_log_process(void);
+uint32_t selftest_log_count(void);
+uint32_t selftest_log_read(uint32_t index, selftest_log_record_t *record);
+void selftest_log_clear(void);
+void selftest_log_dump(void);
+
+#endif /* SELFTEST_LOG_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,391 @@
+/******************************************************************************
+* File Name:   selftest_lowpower.c
+*
+* Description: This file implements the low power run mode. The WDT match
+*              interrupt wakes the device from deep sleep, the selected self
+*              tests run and are logged, and the device returns to deep sleep.
+*              A falling edge on the UART RX pin wakes it for commands.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+#include <stdio.h>
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "selftest_lowpower.h"
+#include "timebase.h"
+#include "uart_tx.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* WDT counts between two wakeups, the counter and match are 16 bits wide */
+#define SELFTEST_LOWPOWER_WDT_TICKS \
+    ((SELFTEST_LOWPOWER_ILO_HZ / 1000u) * SELFTEST_LOWPOWER_PERIOD_MS)
+#define SELFTEST_LOWPOWER_WDT_MASK         (0xFFFFu)
+
+#if (SELFTEST_LOWPOWER_WDT_TICKS == 0u) || (SELFTEST_LOWPOWER_WDT_TICKS > SELFTEST_LOWPOWER_WDT_MASK)
+#error "SELFTEST_LOWPOWER_PERIOD_MS does not fit the 16-bit WDT counter"
+#endif
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static volatile bool selftest_lowpower_due = false;
+static volatile bool selftest_lowpower_rx_edge = false;
+static uint32_t selftest_lowpower_rx_ms = 0u;
+static bool selftest_lowpower_timer_wake = false;
+static uint32_t selftest_lowpower_wake_cycles = 0u;
+/* WDT counts slept that did not add up to a full millisecond yet */
+static uint32_t selftest_lowpower_sleep_ticks = 0u;
+static selftest_lowpower_stats_t selftest_lowpower_stats;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void selftest_lowpower_wdt_isr(void);
+static void selftest_lowpower_rx_isr(void);
+static void selftest_lowpower_run_tests(void);
+static void selftest_lowpower_record_active(void);
+static void selftest_lowpower_sleep(void);
+
+/*******************************************************************************
+* Function Name: selftest_lowpower_wdt_isr
+********************************************************************************
+* Summary:
+* WDT match interrupt handler. Services the WDT, moves the match one period
+* ahead and flags a test run.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void selftest_lowpower_wdt_isr(void)
+{
+    Cy_WDT_ClearInterrupt();
+    Cy_WDT_SetMatch((Cy_WDT_GetMatch() + SELFTEST_LOWPOWER_WDT_TICKS) & SELFTEST_LOWPOWER_WDT_MASK);
+    selftest_lowpower_due = true;
+}
+
+/*******************************************************************************
+* Function Name: selftest_lowpower_rx_isr
+********************************************************************************
+* Summary:
+* GPIO interrupt handler of the UART RX pin, armed only during deep sleep.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void selftest_lowpower_rx_isr(void)
+{
+    Cy_GPIO_ClearInterrupt(CYBSP_UART_RX_PORT, CYBSP_UART_RX_PIN);
+    selftest_lowpower_rx_edge = true;
+}
+
+/*******************************************************************************
+* Function Name: selftest_lowpower_init
+********************************************************************************
+* Summary:
+* Starts the WDT with a match interrupt every SELFTEST_LOWPOWER_PERIOD_MS and
+* hooks the UART RX pin interrupt. Call after timebase_init().
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_lowpower_init(void)
+{
+    const cy_stc_sysint_t wdt_intr_config =
+    {
+        .intrSrc = SELFTEST_LOWPOWER_WDT_IRQ,
+        .intrPriority = SELFTEST_LOWPOWER_INTR_PRIORITY,
+    };
+    const cy_stc_sysint_t rx_intr_config =
+    {
+        .intrSrc = CYBSP_UART_RX_IRQ,
+        .intrPriority = SELFTEST_LOWPOWER_INTR_PRIORITY,
+    };
+
+    if ((CY_SYSINT_SUCCESS != Cy_SysInt_Init(&wdt_intr_config, &selftest_lowpower_wdt_isr)) ||
+        (CY_SYSINT_SUCCESS != Cy_SysInt_Init(&rx_intr_config, &selftest_lowpower_rx_isr)))
+    {
+        CY_ASSERT(0);
+    }
+
+    Cy_GPIO_SetInterruptEdge(CYBSP_UART_RX_PORT, CYBSP_UART_RX_PIN, CY_GPIO_INTR_DISABLE);
+    Cy_GPIO_ClearInterrupt(CYBSP_UART_RX_PORT, CYBSP_UART_RX_PIN);
+    NVIC_ClearPendingIRQ(rx_intr_config.intrSrc);
+    NVIC_EnableIRQ(rx_intr_config.intrSrc);
+
+    Cy_WDT_SetMatch((Cy_WDT_GetCount() + SELFTEST_LOWPOWER_WDT_TICKS) & SELFTEST_LOWPOWER_WDT_MASK);
+    Cy_WDT_ClearInterrupt();
+    Cy_WDT_UnmaskInterrupt();
+    NVIC_ClearPendingIRQ(wdt_intr_config.intrSrc);
+    NVIC_EnableIRQ(wdt_intr_config.intrSrc);
+    Cy_WDT_Enable();
+
+    selftest_lowpower_rx_ms = timebase_get_ms();
+}
+
+/*******************************************************************************
+* Function Name: selftest_lowpower_notify_rx
+********************************************************************************
+* Summary:
+* Keeps the device awake for SELFTEST_LOWPOWER_AWAKE_MS after a received byte.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_lowpower_notify_rx(void)
+{
+    selftest_lowpower_rx_ms = timebase_get_ms();
+}
+
+/*******************************************************************************
+* Function Name: selftest_lowpower_run_tests
+********************************************************************************
+* Summary:
+* Runs the tests of SELFTEST_LOWPOWER_MASK without text output. The results
+* go to the result log and drift statistics. Peripheral contexts are kept
+* across deep sleep, so only the analog settling time is spent on bring-up.
+* The blocks are enabled before the settling time, which matters on the
+* first wakeup only.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void selftest_lowpower_run_tests(void)
+{
+    uint32_t mask = SELFTEST_LOWPOWER_MASK;
+
+    selftest_enable_blocks(mask);
+    Cy_SysLib_DelayUs(SELFTEST_LOWPOWER_SETTLE_US);
+    selftest_set_quiet(true);
+    selftest_lowpower_stats.fail_mask = selftest_run(mask);
+    selftest_set_quiet(false);
+}
+
+/*******************************************************************************
+* Function Name: selftest_lowpower_record_active
+********************************************************************************
+* Summary:
+* Adds the time from the last timer wakeup until now to the statistics.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void selftest_lowpower_record_active(void)
+{
+    uint32_t active_us = timebase_cycles_to_us(timebase_get_cycles() - selftest_lowpower_wake_cycles);
+
+    selftest_lowpower_stats.wakes++;
+    selftest_lowpower_stats.last_us = active_us;
+    selftest_lowpower_stats.total_us += active_us;
+    if (active_us > selftest_lowpower_stats.max_us)
+    {
+        selftest_lowpower_stats.max_us = active_us;
+    }
+}
+
+/*******************************************************************************
+* Function Name: selftest_lowpower_sleep
+********************************************************************************
+* Summary:
+* Drains the UART, arms the RX pin falling edge interrupt and enters deep
+* sleep until the WDT or the RX pin wakes the device. The byte whose start
+* bit wakes the device is lost, the following ones are received normally.
+* The active time of a timer wakeup is counted up to the next sleep entry.
+* SysTick stops in deep sleep, so the WDT counts slept are added to the
+* time base on wakeup.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void selftest_lowpower_sleep(void)
+{
+    uint32_t intr_state;
+    uint32_t wdt_count;
+
+    uart_tx_flush();
+    if (selftest_lowpower_timer_wake)
+    {
+        selftest_lowpower_record_active();
+    }
+
+    selftest_lowpower_rx_edge = false;
+    Cy_GPIO_ClearInterrupt(CYBSP_UART_RX_PORT, CYBSP_UART_RX_PIN);
+    Cy_GPIO_SetInterruptEdge(CYBSP_UART_RX_PORT, CYBSP_UART_RX_PIN, CY_GPIO_INTR_FALLING);
+
+    /* A WDT match between the check and WFI would otherwise be missed until
+     * the next wakeup. WFI still returns on an interrupt pending while they
+     * are masked, its handler runs once they are enabled again.
+     */
+    intr_state = Cy_SysLib_EnterCriticalSection();
+    if (!selftest_lowpower_due)
+    {
+        wdt_count = Cy_WDT_GetCount();
+        (void)Cy_SysPm_CpuEnterDeepSleep();
+        selftest_lowpower_sleep_ticks += (Cy_WDT_GetCount() - wdt_count) & SELFTEST_LOWPOWER_WDT_MASK;
+        timebase_advance_ms(selftest_lowpower_sleep_ticks / (SELFTEST_LOWPOWER_ILO_HZ / 1000u));
+        selftest_lowpower_sleep_ticks %= (SELFTEST_LOWPOWER_ILO_HZ / 1000u);
+    }
+    Cy_SysLib_ExitCriticalSection(intr_state);
+
+    selftest_lowpower_wake_cycles = timebase_get_cycles();
+    selftest_lowpower_timer_wake = selftest_lowpower_due;
+
+    Cy_GPIO_SetInterruptEdge(CYBSP_UART_RX_PORT, CYBSP_UART_RX_PIN, CY_GPIO_INTR_DISABLE);
+    if (selftest_lowpower_rx_edge)
+    {
+        selftest_lowpower_stats.uart_wakes++;
+        selftest_lowpower_rx_ms = timebase_get_ms();
+    }
+}
+
+/*******************************************************************************
+* Function Name: selftest_lowpower_process
+********************************************************************************
+* Summary:
+* Called from the main loop after the UART commands were handled. Runs the
+* tests when the WDT period elapsed and enters deep sleep unless a UART
+* session is active or a non-blocking test is in progress.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_lowpower_process(void)
+{
+    if (selftest_lowpower_due)
+    {
+        selftest_lowpower_due = false;
+        selftest_lowpower_run_tests();
+    }
+
+    if ((timebase_get_ms() - selftest_lowpower_rx_ms) < SELFTEST_LOWPOWER_AWAKE_MS)
+    {
+        return;
+    }
+#if SELFTEST_SAR_TESTS_ENABLE
+    if (SELFTEST_ASYNC_BUSY == selftest_async_poll())
+    {
+        return;
+    }
+#endif
+
+    selftest_lowpower_sleep();
+}
+
+/*******************************************************************************
+* Function Name: selftest_lowpower_get_stats
+********************************************************************************
+* Summary:
+* Returns the wakeup and active time statistics.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  const selftest_lowpower_stats_t* - statistics
+*
+*******************************************************************************/
+const selftest_lowpower_stats_t *selftest_lowpower_get_stats(void)
+{
+    return &selftest_lowpower_stats;
+}
+
+/*******************************************************************************
+* Function Name: selftest_lowpower_print_stats
+********************************************************************************
+* Summary:
+* Prints the number of wakeups and the active time per timer wakeup. The duty
+* cycle relates the mean active time to SELFTEST_LOWPOWER_PERIOD_MS.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_lowpower_print_stats(void)
+{
+    const selftest_lowpower_stats_t *stats = &selftest_lowpower_stats;
+    uint32_t mean_us = (0u == stats->wakes) ? 0u : (uint32_t)(stats->total_us / stats->wakes);
+    char line[96];
+
+    (void)snprintf(line, sizeof(line),
+            "Low power: wakes=%lu uart=%lu active last=%lu max=%lu mean=%lu us\r\n",
+            (unsigned long)stats->wakes, (unsigned long)stats->uart_wakes,
+            (unsigned long)stats->last_us, (unsigned long)stats->max_us,
+            (unsigned long)mean_us);
+    uart_tx_puts(line);
+    (void)snprintf(line, sizeof(line), "Low power: duty=%lu ppm fail mask=0x%02lx\r\n",
+            (unsigned long)(((uint64_t)mean_us * 1000u) / SELFTEST_LOWPOWER_PERIOD_MS),
+            (unsigned long)stats->fail_mask);
+    uart_tx_puts(line);
+}
+
+/* [] END OF FILE */
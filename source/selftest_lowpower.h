@@ -0,0 +1,121 @@
+/******************************************************************************
+* File Name:   selftest_lowpower.h
+*
+* Description: This file is the public interface of selftest_lowpower.c source
+*              file.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SELFTEST_LOWPOWER_H_
+#define SELFTEST_LOWPOWER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "self_test.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set to 1 to run the self tests from WDT wakeups and deep sleep in between */
+#ifndef SELFTEST_LOWPOWER_ENABLE
+#define SELFTEST_LOWPOWER_ENABLE           0
+#endif
+
+/* Interval between two test runs */
+#ifndef SELFTEST_LOWPOWER_PERIOD_MS
+#define SELFTEST_LOWPOWER_PERIOD_MS        (1000u)
+#endif
+
+/* Tests run on every wakeup. By default, the tests of all built groups for
+ * the selected reference point, as only one reference is wired at a time.
+ */
+#ifndef SELFTEST_LOWPOWER_MASK
+#define SELFTEST_LOWPOWER_MASK             (selftest_get_run_all_mask())
+#endif
+
+/* Time the device stays awake after UART activity to receive commands */
+#ifndef SELFTEST_LOWPOWER_AWAKE_MS
+#define SELFTEST_LOWPOWER_AWAKE_MS         (5000u)
+#endif
+
+/* Settling time of the analog blocks after a deep sleep wakeup */
+#ifndef SELFTEST_LOWPOWER_SETTLE_US
+#define SELFTEST_LOWPOWER_SETTLE_US        (20u)
+#endif
+
+/* Nominal ILO frequency that clocks the WDT counter */
+#ifndef SELFTEST_LOWPOWER_ILO_HZ
+#define SELFTEST_LOWPOWER_ILO_HZ           (40000u)
+#endif
+
+/* SRSS interrupt that carries the WDT match */
+#ifndef SELFTEST_LOWPOWER_WDT_IRQ
+#define SELFTEST_LOWPOWER_WDT_IRQ          (srss_interrupt_IRQn)
+#endif
+
+#define SELFTEST_LOWPOWER_INTR_PRIORITY    (3u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Active time statistics of the timer wakeups */
+typedef struct
+{
+    uint32_t wakes;         /* Timer wakeups from deep sleep */
+    uint32_t uart_wakes;    /* Wakeups by UART RX activity */
+    uint32_t last_us;       /* Active time of the last timer wakeup */
+    uint32_t max_us;        /* Longest active time of a timer wakeup */
+    uint64_t total_us;      /* Active time of all timer wakeups */
+    uint32_t fail_mask;     /* Failed tests of the last test run */
+} selftest_lowpower_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void selftest_lowpower_init(void);
+void selftest_lowpower_notify_rx(void);
+void selftest_lowpower_process(void);
+const selftest_lowpower_stats_t *selftest_lowpower_get_stats(void);
+void selftest_lowpower_print_stats(void);
+
+#endif /* SELFTEST_LOWPOWER_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,172 @@
+/******************************************************************************
+* File Name:   selftest_measure.c
+*
+* Description: This file provides filtered SAR measurements for the ADC and
+*              opamp checks: SAR hardware averaging and an integer median of K
+*              single shot conversions.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+#include "selftest_measure.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static selftest_measure_config_t selftest_measure_config =
+{
+    .median_k = SELFTEST_MEASURE_MEDIAN_K,
+    .avg_log2 = SELFTEST_MEASURE_AVG_LOG2,
+};
+
+/*******************************************************************************
+* Function Name: selftest_measure_set_config
+********************************************************************************
+* Summary:
+* Sets the median filter length and programs SAR hardware averaging for the
+* given channels. An even or out of range median length is rounded down to the
+* next valid odd value. Averaging shifts the sum back to the channel
+* resolution, so expected results and accuracy windows stay unchanged. The
+* SAR wide averaging count is left alone when no channel is given.
+*
+* Parameters:
+*  base     - SAR instance
+*  channels - channels whose averaging is switched on or off
+*  count    - number of channels
+*  config   - new measurement mode
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_measure_set_config(SAR_Type *base, const uint32_t *channels, uint32_t count,
+        const selftest_measure_config_t *config)
+{
+    uint32_t idx;
+    uint8_t median_k = config->median_k;
+    uint8_t avg_log2 = config->avg_log2;
+
+    if (median_k > SELFTEST_MEASURE_MAX_K)
+    {
+        median_k = SELFTEST_MEASURE_MAX_K;
+    }
+    if (0u == (median_k & 1u))
+    {
+        median_k = (0u == median_k) ? 1u : (uint8_t)(median_k - 1u);
+    }
+    if (avg_log2 > 8u)
+    {
+        avg_log2 = 8u;
+    }
+    selftest_measure_config.median_k = median_k;
+    selftest_measure_config.avg_log2 = avg_log2;
+
+    if ((0u != avg_log2) && (0u != count))
+    {
+        /* AVG_CNT n averages 2^(n+1) samples */
+        CY_REG32_CLR_SET(SAR_SAMPLE_CTRL(base), SAR_SAMPLE_CTRL_AVG_CNT, avg_log2 - 1u);
+        SAR_SAMPLE_CTRL(base) |= SAR_SAMPLE_CTRL_AVG_SHIFT_Msk;
+    }
+    for (idx = 0u; idx < count; idx++)
+    {
+        if (0u != avg_log2)
+        {
+            SAR_CHAN_CONFIG(base, channels[idx]) |= SAR_CHAN_CONFIG_AVG_EN_Msk;
+        }
+        else
+        {
+            SAR_CHAN_CONFIG(base, channels[idx]) &= ~SAR_CHAN_CONFIG_AVG_EN_Msk;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: selftest_measure_get_config
+********************************************************************************
+* Summary:
+* Returns the active measurement mode.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  const selftest_measure_config_t* - measurement mode
+*
+*******************************************************************************/
+const selftest_measure_config_t *selftest_measure_get_config(void)
+{
+    return &selftest_measure_config;
+}
+
+/*******************************************************************************
+* Function Name: selftest_measure_median
+********************************************************************************
+* Summary:
+* Takes median_k single shot conversions and returns their median. Samples are
+* kept sorted by insertion, so no division or floating point is needed.
+*
+* Parameters:
+*  base    - SAR instance
+*  channel - SAR channel to measure
+*
+* Return :
+*  int16_t - median SAR result in counts
+*
+*******************************************************************************/
+int16_t selftest_measure_median(SAR_Type *base, uint32_t channel)
+{
+    int16_t samples[SELFTEST_MEASURE_MAX_K];
+    int16_t sample;
+    uint32_t taken;
+    uint32_t pos;
+
+    for (taken = 0u; taken < selftest_measure_config.median_k; taken++)
+    {
+        Cy_SAR_StartConvert(base, CY_SAR_START_CONVERT_SINGLE_SHOT);
+        (void)Cy_SAR_IsEndConversion(base, CY_SAR_WAIT_FOR_RESULT);
+        sample = Cy_SAR_GetResult16(base, channel);
+
+        for (pos = taken; (pos > 0u) && (samples[pos - 1u] > sample); pos--)
+        {
+            samples[pos] = samples[pos - 1u];
+        }
+        samples[pos] = sample;
+    }
+
+    return samples[selftest_measure_config.median_k / 2u];
+}
+
+/* [] END OF FILE */
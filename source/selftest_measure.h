@@ -0,0 +1,89 @@
+/******************************************************************************
+* File Name:   selftest_measure.h
+*
+* Description: This file is the public interface of selftest_measure.c source
+*              file.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SELFTEST_MEASURE_H_
+#define SELFTEST_MEASURE_H_
+
+#include <stdint.h>
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Largest supported median filter length */
+#define SELFTEST_MEASURE_MAX_K             (9u)
+
+/* Median filter length applied after reset, 1 disables the filter */
+#ifndef SELFTEST_MEASURE_MEDIAN_K
+#define SELFTEST_MEASURE_MEDIAN_K          (5u)
+#endif
+
+/* SAR hardware averaging applied after reset: 2^n samples, 0 disables it */
+#ifndef SELFTEST_MEASURE_AVG_LOG2
+#define SELFTEST_MEASURE_AVG_LOG2          (0u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Measurement mode of the ADC and opamp checks */
+typedef struct
+{
+    uint8_t median_k;   /* Odd number of conversions, 1 to SELFTEST_MEASURE_MAX_K */
+    uint8_t avg_log2;   /* Hardware averaging of 2^avg_log2 samples, 0 to 8 */
+} selftest_measure_config_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void selftest_measure_set_config(SAR_Type *base, const uint32_t *channels, uint32_t count,
+        const selftest_measure_config_t *config);
+const selftest_measure_config_t *selftest_measure_get_config(void);
+int16_t selftest_measure_median(SAR_Type *base, uint32_t channel);
+
+#endif /* SELFTEST_MEASURE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,287 @@
+/******************************************************************************
+* File Name:   selftest_post.c
+*
+* Description: This file implements the power-on self test. It runs the
+*              analog tests without operator prompts at startup and keeps the
+*              result in a CRC protected record in no-init RAM, so warm resets
+*              can skip the tests while that result is recent and passed.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+#include <stddef.h>
+#include "cy_pdl.h"
+#include "selftest_post.h"
+#include "crc16.h"
+#include "timebase.h"
+#include "uart_tx.h"
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* POST result retained across warm resets */
+typedef struct
+{
+    uint32_t magic;         /* SELFTEST_POST_MAGIC */
+    uint32_t mask;          /* Tests run by the POST */
+    uint32_t fail_mask;     /* Failed tests */
+    uint32_t full_us;       /* Duration of the POST */
+    uint16_t warm_boots;    /* Warm resets that reused this record */
+    uint16_t crc;           /* CRC-16/CCITT of the fields above */
+} selftest_post_record_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Not initialized by the startup code, so it survives warm resets */
+CY_NOINIT static selftest_post_record_t selftest_post_record;
+
+static selftest_post_result_t selftest_post_result;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint16_t selftest_post_crc(const selftest_post_record_t *record);
+static bool selftest_post_reusable(const selftest_post_record_t *record, uint32_t mask);
+
+/*******************************************************************************
+* Function Name: selftest_post_crc
+********************************************************************************
+* Summary:
+* Calculates the CRC of a retained record, excluding the CRC field.
+*
+* Parameters:
+*  record - retained record
+*
+* Return :
+*  uint16_t - CRC-16/CCITT
+*
+*******************************************************************************/
+static uint16_t selftest_post_crc(const selftest_post_record_t *record)
+{
+    return crc16_ccitt(CRC16_CCITT_INIT, (const uint8_t *)record,
+            offsetof(selftest_post_record_t, crc));
+}
+
+/*******************************************************************************
+* Function Name: selftest_post_reusable
+********************************************************************************
+* Summary:
+* Checks whether the retained record holds a passed POST of the same test set
+* that was reused on fewer than SELFTEST_POST_MAX_WARM_BOOTS warm resets.
+*
+* Parameters:
+*  record - retained record
+*  mask   - tests of the POST
+*
+* Return :
+*  bool - true if the POST may be skipped
+*
+*******************************************************************************/
+static bool selftest_post_reusable(const selftest_post_record_t *record, uint32_t mask)
+{
+    return (SELFTEST_POST_MAGIC == record->magic) &&
+           (selftest_post_crc(record) == record->crc) &&
+           (mask == record->mask) &&
+           (0u == record->fail_mask) &&
+           (record->warm_boots < SELFTEST_POST_MAX_WARM_BOOTS);
+}
+
+/*******************************************************************************
+* Function Name: selftest_post_run
+********************************************************************************
+* Summary:
+* Power-on self test. Call once after cybsp_init(), Cy_SAR_Init() and
+* timebase_init(). After a warm reset (SELFTEST_POST_WARM_RESETS) with a
+* reusable retained record, the tests are skipped and the retained result is
+* returned. Otherwise the blocks of the SELFTEST_POST_MASK tests are enabled
+* together and given SELFTEST_POST_SETTLE_US to settle, the tests run quietly
+* with selftest_run(), and their result replaces the retained record. The reset
+* reason is cleared.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  uint32_t - bitmap of SELFTEST_MASK(id) values of the failed tests
+*
+*******************************************************************************/
+uint32_t selftest_post_run(void)
+{
+    selftest_post_record_t *record = &selftest_post_record;
+    selftest_post_result_t *result = &selftest_post_result;
+    uint32_t mask = SELFTEST_POST_MASK;
+    uint32_t start = timebase_get_cycles();
+
+    result->reset_reason = Cy_SysLib_GetResetReason();
+    Cy_SysLib_ClearResetReason();
+
+    result->cached = (0u != (result->reset_reason & SELFTEST_POST_WARM_RESETS)) &&
+                     selftest_post_reusable(record, mask);
+    if (result->cached)
+    {
+        record->warm_boots++;
+    }
+    else
+    {
+        selftest_enable_blocks(mask);
+        Cy_SysLib_DelayUs(SELFTEST_POST_SETTLE_US);
+        selftest_set_quiet(true);
+        record->fail_mask = selftest_run(mask);
+        selftest_set_quiet(false);
+
+        record->magic = SELFTEST_POST_MAGIC;
+        record->mask = mask;
+        record->warm_boots = 0u;
+        record->full_us = timebase_cycles_to_us(timebase_get_cycles() - start);
+    }
+    record->crc = selftest_post_crc(record);
+
+    result->fail_mask = record->fail_mask;
+    result->full_us = record->full_us;
+    result->warm_boots = record->warm_boots;
+    result->boot_us = timebase_cycles_to_us(timebase_get_cycles() - start);
+
+    return result->fail_mask;
+}
+
+/*******************************************************************************
+* Function Name: selftest_post_get_result
+********************************************************************************
+* Summary:
+* Returns the outcome of the power-on self test of the current boot.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  const selftest_post_result_t * - POST outcome
+*
+*******************************************************************************/
+const selftest_post_result_t *selftest_post_get_result(void)
+{
+    return &selftest_post_result;
+}
+
+/*******************************************************************************
+* Function Name: selftest_post_print
+********************************************************************************
+* Summary:
+* Prints whether the POST ran or its retained result was reused, the time it
+* took during this boot, and the duration of the last full POST.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_post_print(void)
+{
+    const selftest_post_result_t *result = &selftest_post_result;
+    char line[96];
+
+    (void)snprintf(line, sizeof(line), "POST: %s, reset reason 0x%02lx, fail mask 0x%02lx\r\n",
+            result->cached ? "retained result" : "full run",
+            (unsigned long)result->reset_reason, (unsigned long)result->fail_mask);
+    uart_tx_puts(line);
+    (void)snprintf(line, sizeof(line), "POST: boot %lu us, full POST %lu us, warm boots %lu\r\n",
+            (unsigned long)result->boot_us, (unsigned long)result->full_us,
+            (unsigned long)result->warm_boots);
+    uart_tx_puts(line);
+}
+
+/*******************************************************************************
+* Function Name: selftest_post_reset
+********************************************************************************
+* Summary:
+* Sends the pending UART output and performs a software reset, a warm reset
+* that may reuse the retained POST result.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_post_reset(void)
+{
+    uart_tx_flush();
+    NVIC_SystemReset();
+}
+
+/*******************************************************************************
+* Function Name: selftest_post_halt
+********************************************************************************
+* Summary:
+* Safe state after a failed POST, entered when SELFTEST_POST_HALT_ON_FAIL is
+* set. Prints the failed tests, sends the pending UART output and stops with
+* interrupts disabled. The failed result is retained, so the next reset runs
+* the full POST again.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_post_halt(void)
+{
+    char line[64];
+    uint32_t id;
+
+    uart_tx_puts("POST failed, application not started:");
+    for (id = 0u; id < (uint32_t)SELFTEST_ID_COUNT; id++)
+    {
+        if (0u != (selftest_post_result.fail_mask & SELFTEST_MASK(id)))
+        {
+            (void)snprintf(line, sizeof(line), " %s", selftest_names[id]);
+            uart_tx_puts(line);
+        }
+    }
+    uart_tx_puts("\r\n");
+    uart_tx_flush();
+
+    __disable_irq();
+    for (;;)
+    {
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,122 @@
+/******************************************************************************
+* File Name:   selftest_post.h
+*
+* Description: This file is the public interface of selftest_post.c source
+*              file.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SELFTEST_POST_H_
+#define SELFTEST_POST_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "self_test.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set to 0 to start without the power-on self test */
+#ifndef SELFTEST_POST_ENABLE
+#define SELFTEST_POST_ENABLE               1
+#endif
+
+/* Set to 1 to stop in selftest_post_halt() when the POST fails. By default a
+ * failed POST is reported and the application starts, so the example remains
+ * usable on a kit whose reference signals are not wired.
+ */
+#ifndef SELFTEST_POST_HALT_ON_FAIL
+#define SELFTEST_POST_HALT_ON_FAIL         0
+#endif
+
+/* Tests of the power-on self test, one reference point per test by default */
+#ifndef SELFTEST_POST_MASK
+#define SELFTEST_POST_MASK                 (selftest_get_run_all_mask())
+#endif
+
+/* Settling time of the analog blocks after they are enabled, before the first test */
+#ifndef SELFTEST_POST_SETTLE_US
+#define SELFTEST_POST_SETTLE_US            (10u)
+#endif
+
+/* Number of warm resets that may reuse a passed POST before it runs again,
+ * 0 runs the POST on every reset
+ */
+#ifndef SELFTEST_POST_MAX_WARM_BOOTS
+#define SELFTEST_POST_MAX_WARM_BOOTS       (8u)
+#endif
+
+/* Reset causes that keep RAM content and may reuse the retained result. A
+ * watchdog reset may be caused by a fault and always runs the full POST.
+ */
+#ifndef SELFTEST_POST_WARM_RESETS
+#define SELFTEST_POST_WARM_RESETS          (CY_SYSLIB_RESET_SOFT)
+#endif
+
+/* "POST" */
+#define SELFTEST_POST_MAGIC                (0x54534F50uL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Outcome of the power-on self test of the current boot */
+typedef struct
+{
+    bool cached;            /* Result taken from the retained record */
+    uint32_t reset_reason;  /* Cy_SysLib_GetResetReason() at boot */
+    uint32_t fail_mask;     /* Failed tests of the result in use */
+    uint32_t boot_us;       /* Time spent in selftest_post_run() */
+    uint32_t full_us;       /* Duration of the last full POST */
+    uint32_t warm_boots;    /* Warm resets that reused the retained record */
+} selftest_post_result_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint32_t selftest_post_run(void);
+const selftest_post_result_t *selftest_post_get_result(void);
+void selftest_post_print(void);
+void selftest_post_reset(void);
+void selftest_post_halt(void);
+
+#endif /* SELFTEST_POST_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,496 @@
+/******************************************************************************
+* File Name:   selftest_proto.c
+*
+* Description: This file implements a framed binary command protocol for
+*              automated test racks. It shares the UART with the one character
+*              commands and answers with compact binary responses.
+*
+*              Frame: SOF, LEN, LEN payload bytes (command first), CRC16
+*              (CCITT, init 0xFFFF) over LEN and payload, little endian.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+#include "cy_pdl.h"
+#include <string.h>
+#include "selftest_proto.h"
+#include "crc16.h"
+#include "self_test.h"
+#include "selftest_log.h"
+#include "selftest_drift.h"
+#include "timebase.h"
+#include "uart_tx.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Argument sizes of the request commands */
+#define SELFTEST_PROTO_RUN_ARGS            (6u)
+#define SELFTEST_PROTO_GET_LOG_ARGS        (3u)
+
+/* Records that fit into one GET_LOG response after its 5 byte preamble */
+#define SELFTEST_PROTO_LOG_MAX_RECORDS \
+    ((SELFTEST_PROTO_MAX_PAYLOAD - 5u) / sizeof(selftest_log_record_t))
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    SELFTEST_PROTO_WAIT_SOF,
+    SELFTEST_PROTO_WAIT_LEN,
+    SELFTEST_PROTO_WAIT_PAYLOAD,
+    SELFTEST_PROTO_WAIT_CRC_LO,
+    SELFTEST_PROTO_WAIT_CRC_HI
+} selftest_proto_state_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static selftest_proto_state_t selftest_proto_state = SELFTEST_PROTO_WAIT_SOF;
+static uint32_t selftest_proto_last_ms = 0u;
+static uint8_t selftest_proto_rx[SELFTEST_PROTO_MAX_PAYLOAD];
+static uint32_t selftest_proto_rx_len = 0u;
+static uint32_t selftest_proto_rx_fill = 0u;
+static uint16_t selftest_proto_rx_crc = 0u;
+static uint8_t selftest_proto_tx[SELFTEST_PROTO_MAX_PAYLOAD];
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t selftest_proto_put16(uint8_t *dst, uint16_t value);
+static uint32_t selftest_proto_put32(uint8_t *dst, uint32_t value);
+static void selftest_proto_send(uint32_t size);
+static uint32_t selftest_proto_run(const uint8_t *args, uint32_t size);
+static uint32_t selftest_proto_get_stats(void);
+static uint32_t selftest_proto_get_log(const uint8_t *args, uint32_t size);
+static uint32_t selftest_proto_get_drift(void);
+static void selftest_proto_dispatch(void);
+
+/*******************************************************************************
+* Function Name: selftest_proto_put16
+********************************************************************************
+* Summary:
+* Stores a 16-bit value little endian.
+*
+* Parameters:
+*  dst   - destination
+*  value - value to store
+*
+* Return :
+*  uint32_t - number of bytes written
+*
+*******************************************************************************/
+static uint32_t selftest_proto_put16(uint8_t *dst, uint16_t value)
+{
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8u);
+
+    return 2u;
+}
+
+/*******************************************************************************
+* Function Name: selftest_proto_put32
+********************************************************************************
+* Summary:
+* Stores a 32-bit value little endian.
+*
+* Parameters:
+*  dst   - destination
+*  value - value to store
+*
+* Return :
+*  uint32_t - number of bytes written
+*
+*******************************************************************************/
+static uint32_t selftest_proto_put32(uint8_t *dst, uint32_t value)
+{
+    (void)selftest_proto_put16(dst, (uint16_t)value);
+    (void)selftest_proto_put16(&dst[2], (uint16_t)(value >> 16u));
+
+    return 4u;
+}
+
+/*******************************************************************************
+* Function Name: selftest_proto_send
+********************************************************************************
+* Summary:
+* Frames the response payload in selftest_proto_tx and queues it. The TX ring
+* buffer blocks instead of dropping bytes while the frame is queued.
+*
+* Parameters:
+*  size - payload size, command byte included
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void selftest_proto_send(uint32_t size)
+{
+    uart_tx_overflow_policy_t policy = uart_tx_get_overflow_policy();
+    uint8_t head[2];
+    uint8_t crc[2];
+    uint16_t value;
+
+    head[0] = SELFTEST_PROTO_SOF;
+    head[1] = (uint8_t)size;
+    value = crc16_ccitt(CRC16_CCITT_INIT, &head[1], 1u);
+    value = crc16_ccitt(value, selftest_proto_tx, size);
+    (void)selftest_proto_put16(crc, value);
+
+    uart_tx_set_overflow_policy(UART_TX_OVERFLOW_BLOCK);
+    uart_tx_write(head, sizeof(head));
+    uart_tx_write(selftest_proto_tx, size);
+    uart_tx_write(crc, sizeof(crc));
+    uart_tx_set_overflow_policy(policy);
+}
+
+/*******************************************************************************
+* Function Name: selftest_proto_run
+********************************************************************************
+* Summary:
+* RUN command: executes the tests in the mask the requested number of times
+* without text output. Response: status, uint16 runs, uint32 OR of the fail
+* masks, then one uint16 failure count per test point.
+*
+* Parameters:
+*  args - uint32 mask, uint16 repeat count
+*  size - number of argument bytes
+*
+* Return :
+*  uint32_t - response payload size
+*
+*******************************************************************************/
+static uint32_t selftest_proto_run(const uint8_t *args, uint32_t size)
+{
+    uint32_t mask;
+    uint32_t repeat;
+    uint32_t run;
+    uint32_t fail_mask = 0u;
+    uint32_t fail_mask_any = 0u;
+    uint16_t failures[SELFTEST_ID_COUNT] = { 0u };
+    uint32_t id;
+    uint32_t pos = 2u;
+
+    if (SELFTEST_PROTO_RUN_ARGS != size)
+    {
+        selftest_proto_tx[1] = SELFTEST_PROTO_STATUS_BAD_LENGTH;
+        return 2u;
+    }
+    mask = (uint32_t)args[0] | ((uint32_t)args[1] << 8u) |
+           ((uint32_t)args[2] << 16u) | ((uint32_t)args[3] << 24u);
+    repeat = (uint32_t)args[4] | ((uint32_t)args[5] << 8u);
+
+    selftest_set_quiet(true);
+    for (run = 0u; run < repeat; run++)
+    {
+        fail_mask = selftest_run(mask);
+        fail_mask_any |= fail_mask;
+        for (id = 0u; id < (uint32_t)SELFTEST_ID_COUNT; id++)
+        {
+            if (0u != (fail_mask & SELFTEST_MASK(id)))
+            {
+                failures[id]++;
+            }
+        }
+    }
+    selftest_set_quiet(false);
+
+    selftest_proto_tx[1] = SELFTEST_PROTO_STATUS_OK;
+    pos += selftest_proto_put16(&selftest_proto_tx[pos], (uint16_t)repeat);
+    pos += selftest_proto_put32(&selftest_proto_tx[pos], fail_mask_any);
+    for (id = 0u; id < (uint32_t)SELFTEST_ID_COUNT; id++)
+    {
+        pos += selftest_proto_put16(&selftest_proto_tx[pos], failures[id]);
+    }
+
+    return pos;
+}
+
+/*******************************************************************************
+* Function Name: selftest_proto_get_stats
+********************************************************************************
+* Summary:
+* GET_STATS command. Response: status, uint8 number of test points, then
+* uint32 runs and uint32 failures per test point in selftest_id_t order.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  uint32_t - response payload size
+*
+*******************************************************************************/
+static uint32_t selftest_proto_get_stats(void)
+{
+    const selftest_result_stats_t *stats = selftest_get_result_stats();
+    uint32_t id;
+    uint32_t pos = 2u;
+
+    selftest_proto_tx[1] = SELFTEST_PROTO_STATUS_OK;
+    selftest_proto_tx[pos] = (uint8_t)SELFTEST_ID_COUNT;
+    pos++;
+    for (id = 0u; id < (uint32_t)SELFTEST_ID_COUNT; id++)
+    {
+        pos += selftest_proto_put32(&selftest_proto_tx[pos], stats[id].runs);
+        pos += selftest_proto_put32(&selftest_proto_tx[pos], stats[id].failures);
+    }
+
+    return pos;
+}
+
+/*******************************************************************************
+* Function Name: selftest_proto_get_log
+********************************************************************************
+* Summary:
+* GET_LOG command: returns up to the requested number of records starting at
+* a log index, 0 being the oldest record held. Response: status, uint16 records
+* held, uint8 records returned, then the selftest_log_record_t records.
+*
+* Parameters:
+*  args - uint16 first index, uint8 maximum count
+*  size - number of argument bytes
+*
+* Return :
+*  uint32_t - response payload size
+*
+*******************************************************************************/
+static uint32_t selftest_proto_get_log(const uint8_t *args, uint32_t size)
+{
+    selftest_log_record_t record;
+    uint32_t first;
+    uint32_t count;
+    uint32_t sent = 0u;
+    uint32_t pos = 5u;
+
+    if (SELFTEST_PROTO_GET_LOG_ARGS != size)
+    {
+        selftest_proto_tx[1] = SELFTEST_PROTO_STATUS_BAD_LENGTH;
+        return 2u;
+    }
+    first = (uint32_t)args[0] | ((uint32_t)args[1] << 8u);
+    count = (args[2] < SELFTEST_PROTO_LOG_MAX_RECORDS) ? args[2] : SELFTEST_PROTO_LOG_MAX_RECORDS;
+
+    while ((sent < count) && (0u != selftest_log_read(first + sent, &record)))
+    {
+        (void)memcpy(&selftest_proto_tx[pos], &record, sizeof(record));
+        pos += sizeof(record);
+        sent++;
+    }
+
+    selftest_proto_tx[1] = SELFTEST_PROTO_STATUS_OK;
+    (void)selftest_proto_put16(&selftest_proto_tx[2], (uint16_t)selftest_log_count());
+    selftest_proto_tx[4] = (uint8_t)sent;
+
+    return pos;
+}
+
+/*******************************************************************************
+* Function Name: selftest_proto_get_drift
+********************************************************************************
+* Summary:
+* GET_DRIFT command. Response: status, uint32 early warning mask, uint8 number
+* of test points, then per test point uint32 samples, int32 mean, uint32
+* variance and int32 EWMA (8 fractional bits each) and int16 min and max.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  uint32_t - response payload size
+*
+*******************************************************************************/
+static uint32_t selftest_proto_get_drift(void)
+{
+    const selftest_drift_stats_t *stats;
+    uint32_t id;
+    uint32_t pos = 2u;
+
+    selftest_proto_tx[1] = SELFTEST_PROTO_STATUS_OK;
+    pos += selftest_proto_put32(&selftest_proto_tx[pos], selftest_drift_get_warnings());
+    selftest_proto_tx[pos] = (uint8_t)SELFTEST_ID_COUNT;
+    pos++;
+    for (id = 0u; id < (uint32_t)SELFTEST_ID_COUNT; id++)
+    {
+        stats = selftest_drift_get((selftest_id_t)id);
+        pos += selftest_proto_put32(&selftest_proto_tx[pos], stats->count);
+        pos += selftest_proto_put32(&selftest_proto_tx[pos], (uint32_t)stats->mean);
+        pos += selftest_proto_put32(&selftest_proto_tx[pos],
+                selftest_drift_get_variance((selftest_id_t)id));
+        pos += selftest_proto_put32(&selftest_proto_tx[pos], (uint32_t)stats->ewma);
+        pos += selftest_proto_put16(&selftest_proto_tx[pos], (uint16_t)stats->min);
+        pos += selftest_proto_put16(&selftest_proto_tx[pos], (uint16_t)stats->max);
+    }
+
+    return pos;
+}
+
+/*******************************************************************************
+* Function Name: selftest_proto_dispatch
+********************************************************************************
+* Summary:
+* Executes a received frame with a valid CRC and sends the response.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void selftest_proto_dispatch(void)
+{
+    uint8_t cmd = selftest_proto_rx[0];
+    const uint8_t *args = &selftest_proto_rx[1];
+    uint32_t args_size = selftest_proto_rx_len - 1u;
+    uint32_t size;
+
+    selftest_proto_tx[0] = (uint8_t)(cmd | SELFTEST_PROTO_RESPONSE);
+
+    switch (cmd)
+    {
+        case SELFTEST_PROTO_CMD_RUN:
+            size = selftest_proto_run(args, args_size);
+            break;
+
+        case SELFTEST_PROTO_CMD_GET_STATS:
+            size = selftest_proto_get_stats();
+            break;
+
+        case SELFTEST_PROTO_CMD_GET_LOG:
+            size = selftest_proto_get_log(args, args_size);
+            break;
+
+        case SELFTEST_PROTO_CMD_GET_DRIFT:
+            size = selftest_proto_get_drift();
+            break;
+
+        default:
+            selftest_proto_tx[1] = SELFTEST_PROTO_STATUS_UNKNOWN_CMD;
+            size = 2u;
+            break;
+    }
+
+    selftest_proto_send(size);
+}
+
+/*******************************************************************************
+* Function Name: selftest_proto_feed
+********************************************************************************
+* Summary:
+* Passes one received byte to the frame parser. A byte that is neither part of
+* a frame nor a start of frame is left to the one character command handler.
+* Frames with a bad CRC are answered with SELFTEST_PROTO_STATUS_BAD_CRC.
+*
+* Parameters:
+*  byte - received byte
+*
+* Return :
+*  bool - true if the byte was consumed by the protocol
+*
+*******************************************************************************/
+bool selftest_proto_feed(uint8_t byte)
+{
+    uint32_t now = timebase_get_ms();
+    uint16_t crc;
+    uint8_t len;
+
+    if ((SELFTEST_PROTO_WAIT_SOF != selftest_proto_state) &&
+        ((now - selftest_proto_last_ms) > SELFTEST_PROTO_TIMEOUT_MS))
+    {
+        selftest_proto_state = SELFTEST_PROTO_WAIT_SOF;
+    }
+    selftest_proto_last_ms = now;
+
+    switch (selftest_proto_state)
+    {
+        case SELFTEST_PROTO_WAIT_SOF:
+            if (SELFTEST_PROTO_SOF != byte)
+            {
+                return false;
+            }
+            selftest_proto_state = SELFTEST_PROTO_WAIT_LEN;
+            break;
+
+        case SELFTEST_PROTO_WAIT_LEN:
+            if (0u == byte)
+            {
+                selftest_proto_state = SELFTEST_PROTO_WAIT_SOF;
+                break;
+            }
+            selftest_proto_rx_len = byte;
+            selftest_proto_rx_fill = 0u;
+            selftest_proto_state = SELFTEST_PROTO_WAIT_PAYLOAD;
+            break;
+
+        case SELFTEST_PROTO_WAIT_PAYLOAD:
+            selftest_proto_rx[selftest_proto_rx_fill] = byte;
+            selftest_proto_rx_fill++;
+            if (selftest_proto_rx_fill == selftest_proto_rx_len)
+            {
+                selftest_proto_state = SELFTEST_PROTO_WAIT_CRC_LO;
+            }
+            break;
+
+        case SELFTEST_PROTO_WAIT_CRC_LO:
+            selftest_proto_rx_crc = byte;
+            selftest_proto_state = SELFTEST_PROTO_WAIT_CRC_HI;
+            break;
+
+        default:
+            len = (uint8_t)selftest_proto_rx_len;
+            crc = crc16_ccitt(CRC16_CCITT_INIT, &len, 1u);
+            crc = crc16_ccitt(crc, selftest_proto_rx, selftest_proto_rx_len);
+            selftest_proto_rx_crc |= (uint16_t)((uint16_t)byte << 8u);
+            selftest_proto_state = SELFTEST_PROTO_WAIT_SOF;
+
+            if (crc == selftest_proto_rx_crc)
+            {
+                selftest_proto_dispatch();
+            }
+            else
+            {
+                selftest_proto_tx[0] = (uint8_t)(selftest_proto_rx[0] | SELFTEST_PROTO_RESPONSE);
+                selftest_proto_tx[1] = SELFTEST_PROTO_STATUS_BAD_CRC;
+                selftest_proto_send(2u);
+            }
+            break;
+    }
+
+    return true;
+}
+
+/* [] END OF FILE */
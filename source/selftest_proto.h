@@ -0,0 +1,89 @@
+/******************************************************************************
+* File Name:   selftest_proto.h
+*
+* Description: This file is the public interface of selftest_proto.c source
+*              file.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SELFTEST_PROTO_H_
+#define SELFTEST_PROTO_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Start of frame. Not a printable character, so it cannot collide with the
+ * one character commands.
+ */
+#define SELFTEST_PROTO_SOF                 (0xA5u)
+
+/* Largest payload (command byte included) of a frame */
+#define SELFTEST_PROTO_MAX_PAYLOAD         (255u)
+
+/* A partially received frame is discarded after this gap between two bytes */
+#ifndef SELFTEST_PROTO_TIMEOUT_MS
+#define SELFTEST_PROTO_TIMEOUT_MS          (50u)
+#endif
+
+/* Request commands, the response carries (command | SELFTEST_PROTO_RESPONSE) */
+#define SELFTEST_PROTO_CMD_RUN             (0x01u)  /* uint32 mask, uint16 repeat */
+#define SELFTEST_PROTO_CMD_GET_STATS       (0x02u)  /* no arguments */
+#define SELFTEST_PROTO_CMD_GET_LOG         (0x03u)  /* uint16 first, uint8 count */
+#define SELFTEST_PROTO_CMD_GET_DRIFT       (0x04u)  /* no arguments */
+#define SELFTEST_PROTO_RESPONSE            (0x80u)
+
+/* Response status, first byte after the command */
+#define SELFTEST_PROTO_STATUS_OK           (0x00u)
+#define SELFTEST_PROTO_STATUS_BAD_CRC      (0x01u)
+#define SELFTEST_PROTO_STATUS_BAD_LENGTH   (0x02u)
+#define SELFTEST_PROTO_STATUS_UNKNOWN_CMD  (0x03u)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool selftest_proto_feed(uint8_t byte);
+
+#endif /* SELFTEST_PROTO_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,205 @@
+/******************************************************************************
+* File Name:   selftest_timing.c
+*
+* Description: This file keeps min/max/mean and a latency histogram for each
+*              self test and each underlying STL call.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+#include <stdio.h>
+#include "selftest_timing.h"
+
+#if SELFTEST_TIMING_ENABLE
+#include "uart_tx.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static selftest_timing_stats_t selftest_timing_stats[SELFTEST_TIMING_POINT_COUNT];
+
+static const char * const selftest_timing_names[SELFTEST_TIMING_POINT_COUNT] =
+{
+    "adc_test",
+    "comparator_test",
+    "opamp_test",
+    "adc_multi_channel_test",
+    "SelfTests_ADC",
+    "SelfTests_Comparator",
+    "SelfTests_Opamp",
+};
+
+/*******************************************************************************
+* Function Name: selftest_timing_reset
+********************************************************************************
+* Summary:
+* Clears the statistics of all measured sections.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_timing_reset(void)
+{
+    uint32_t point;
+
+    for (point = 0u; point < (uint32_t)SELFTEST_TIMING_POINT_COUNT; point++)
+    {
+        selftest_timing_stats[point] = (selftest_timing_stats_t){ 0u };
+    }
+}
+
+/*******************************************************************************
+* Function Name: selftest_timing_record
+********************************************************************************
+* Summary:
+* Adds one duration to the statistics of a section. Does not read the clock,
+* so it can be fed from any cycle source.
+*
+* Parameters:
+*  point  - measured section
+*  cycles - duration in CPU cycles
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_timing_record(selftest_timing_point_t point, uint32_t cycles)
+{
+    selftest_timing_stats_t *stats;
+    uint32_t bucket = 0u;
+    uint32_t bound = cycles >> SELFTEST_TIMING_HIST_SHIFT;
+
+    if ((uint32_t)point >= (uint32_t)SELFTEST_TIMING_POINT_COUNT)
+    {
+        return;
+    }
+    stats = &selftest_timing_stats[point];
+
+    if ((0u == stats->count) || (cycles < stats->min))
+    {
+        stats->min = cycles;
+    }
+    if (cycles > stats->max)
+    {
+        stats->max = cycles;
+    }
+    stats->sum += cycles;
+    stats->count++;
+
+    while ((0u != bound) && (bucket < (SELFTEST_TIMING_HIST_BUCKETS - 1u)))
+    {
+        bound >>= 1u;
+        bucket++;
+    }
+    stats->histogram[bucket]++;
+}
+
+/*******************************************************************************
+* Function Name: selftest_timing_get
+********************************************************************************
+* Summary:
+* Returns the statistics of a section.
+*
+* Parameters:
+*  point - measured section
+*
+* Return :
+*  const selftest_timing_stats_t* - statistics, or NULL for an invalid section
+*
+*******************************************************************************/
+const selftest_timing_stats_t *selftest_timing_get(selftest_timing_point_t point)
+{
+    return ((uint32_t)point < (uint32_t)SELFTEST_TIMING_POINT_COUNT) ?
+            &selftest_timing_stats[point] : NULL;
+}
+
+/*******************************************************************************
+* Function Name: selftest_timing_print
+********************************************************************************
+* Summary:
+* Prints count, min, max and mean in microseconds followed by the histogram
+* bucket counts of every section that has been measured.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void selftest_timing_print(void)
+{
+    char line[80];
+    uint32_t point;
+    uint32_t bucket;
+    const selftest_timing_stats_t *stats;
+
+    (void)snprintf(line, sizeof(line), "Histogram bucket 0 < %lu us, doubling per bucket\r\n",
+            (unsigned long)timebase_cycles_to_us(1uL << SELFTEST_TIMING_HIST_SHIFT));
+    uart_tx_puts(line);
+
+    for (point = 0u; point < (uint32_t)SELFTEST_TIMING_POINT_COUNT; point++)
+    {
+        stats = &selftest_timing_stats[point];
+        if (0u == stats->count)
+        {
+            continue;
+        }
+
+        (void)snprintf(line, sizeof(line), "%-20s n=%lu min=%lu max=%lu mean=%lu us\r\n  ",
+                selftest_timing_names[point],
+                (unsigned long)stats->count,
+                (unsigned long)timebase_cycles_to_us(stats->min),
+                (unsigned long)timebase_cycles_to_us(stats->max),
+                (unsigned long)timebase_cycles_to_us((uint32_t)(stats->sum / stats->count)));
+        uart_tx_puts(line);
+
+        for (bucket = 0u; bucket < SELFTEST_TIMING_HIST_BUCKETS; bucket++)
+        {
+            (void)snprintf(line, sizeof(line), " %lu", (unsigned long)stats->histogram[bucket]);
+            uart_tx_puts(line);
+        }
+        uart_tx_puts("\r\n");
+    }
+}
+
+#endif /* SELFTEST_TIMING_ENABLE */
+
+/* [] END OF FILE */
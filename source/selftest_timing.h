@@ -0,0 +1,119 @@
+/******************************************************************************
+* File Name:   selftest_timing.h
+*
+* Description: This file is the public interface of selftest_timing.c source
+*              file. With SELFTEST_TIMING_ENABLE set to 0 the instrumentation
+*              macros expand to nothing and no RAM is used.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SELFTEST_TIMING_H_
+#define SELFTEST_TIMING_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set to 0 to remove the timing instrumentation */
+#ifndef SELFTEST_TIMING_ENABLE
+#define SELFTEST_TIMING_ENABLE             1
+#endif
+
+/* Number of histogram buckets. Bucket 0 holds durations below
+ * 2^SELFTEST_TIMING_HIST_SHIFT cycles, every further bucket doubles the bound,
+ * the last bucket holds everything above.
+ */
+#define SELFTEST_TIMING_HIST_BUCKETS       (12u)
+#define SELFTEST_TIMING_HIST_SHIFT         (8u)
+
+#if SELFTEST_TIMING_ENABLE
+#include "timebase.h"
+
+#define SELFTEST_TIMING_DECLARE(start)     uint32_t start = 0u
+#define SELFTEST_TIMING_START(start)       ((start) = timebase_get_cycles())
+#define SELFTEST_TIMING_STOP(point, start) \
+    selftest_timing_record((point), timebase_get_cycles() - (start))
+#else
+#define SELFTEST_TIMING_DECLARE(start)
+#define SELFTEST_TIMING_START(start)
+#define SELFTEST_TIMING_STOP(point, start)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Measured code sections */
+typedef enum
+{
+    SELFTEST_TIMING_ADC_TEST,
+    SELFTEST_TIMING_COMPARATOR_TEST,
+    SELFTEST_TIMING_OPAMP_TEST,
+    SELFTEST_TIMING_ADC_SCAN_TEST,
+    SELFTEST_TIMING_STL_ADC,
+    SELFTEST_TIMING_STL_COMPARATOR,
+    SELFTEST_TIMING_STL_OPAMP,
+    SELFTEST_TIMING_POINT_COUNT
+} selftest_timing_point_t;
+
+/* Statistics of one measured section, all durations in CPU cycles */
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t histogram[SELFTEST_TIMING_HIST_BUCKETS];
+} selftest_timing_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if SELFTEST_TIMING_ENABLE
+void selftest_timing_reset(void);
+void selftest_timing_record(selftest_timing_point_t point, uint32_t cycles);
+const selftest_timing_stats_t *selftest_timing_get(selftest_timing_point_t point);
+void selftest_timing_print(void);
+#endif
+
+#endif /* SELFTEST_TIMING_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,285 @@
+/******************************************************************************
+* File Name:   stack_monitor.c
+*
+* Description: This file measures stack high-water marks by painting the
+*              unused part of the stack with a pattern and searching for the
+*              lowest overwritten word afterwards.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+#include "cy_pdl.h"
+#include "stack_monitor.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Bounds of the stack region reserved by the linker script of the toolchain */
+#if defined(__ARMCC_VERSION)
+extern uint32_t Image$$ARM_LIB_STACK$$ZI$$Base[];
+extern uint32_t Image$$ARM_LIB_STACK$$ZI$$Limit[];
+#define STACK_MONITOR_LIMIT                ((uint32_t)Image$$ARM_LIB_STACK$$ZI$$Base)
+#define STACK_MONITOR_TOP                  ((uint32_t)Image$$ARM_LIB_STACK$$ZI$$Limit)
+#elif defined(__ICCARM__)
+#pragma section = "CSTACK"
+#define STACK_MONITOR_LIMIT                ((uint32_t)__section_begin("CSTACK"))
+#define STACK_MONITOR_TOP                  ((uint32_t)__section_end("CSTACK"))
+#else
+extern uint32_t __StackLimit[];
+extern uint32_t __StackTop[];
+#define STACK_MONITOR_LIMIT                ((uint32_t)__StackLimit)
+#define STACK_MONITOR_TOP                  ((uint32_t)__StackTop)
+#endif
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Largest stack use since stack_monitor_init(), in bytes */
+static uint32_t stack_monitor_peak = 0u;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void stack_monitor_paint(uint32_t start, uint32_t sp);
+static uint32_t stack_monitor_lowest_used(void);
+static void stack_monitor_update_peak(uint32_t lowest);
+
+/*******************************************************************************
+* Function Name: stack_monitor_paint
+********************************************************************************
+* Summary:
+* Fills the stack from a start address up to STACK_MONITOR_GUARD bytes below
+* the given stack pointer with STACK_MONITOR_PATTERN.
+*
+* Parameters:
+*  start - lowest address to paint, word aligned
+*  sp    - current stack pointer
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void stack_monitor_paint(uint32_t start, uint32_t sp)
+{
+    volatile uint32_t *word = (volatile uint32_t *)start;
+    volatile uint32_t *end = (volatile uint32_t *)(sp - STACK_MONITOR_GUARD);
+
+    while (word < end)
+    {
+        *word = STACK_MONITOR_PATTERN;
+        word++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: stack_monitor_lowest_used
+********************************************************************************
+* Summary:
+* Searches upward from the stack limit for the first word that no longer
+* holds the pattern.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  uint32_t - lowest stack address written since the last painting
+*
+*******************************************************************************/
+static uint32_t stack_monitor_lowest_used(void)
+{
+    const volatile uint32_t *word = (const volatile uint32_t *)STACK_MONITOR_LIMIT;
+    const volatile uint32_t *top = (const volatile uint32_t *)STACK_MONITOR_TOP;
+
+    while ((word < top) && (STACK_MONITOR_PATTERN == *word))
+    {
+        word++;
+    }
+
+    return (uint32_t)word;
+}
+
+/*******************************************************************************
+* Function Name: stack_monitor_update_peak
+********************************************************************************
+* Summary:
+* Folds the use since the last painting into the overall peak.
+*
+* Parameters:
+*  lowest - lowest used stack address from stack_monitor_lowest_used()
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void stack_monitor_update_peak(uint32_t lowest)
+{
+    uint32_t used = STACK_MONITOR_TOP - lowest;
+
+    if (used > stack_monitor_peak)
+    {
+        stack_monitor_peak = used;
+    }
+}
+
+/*******************************************************************************
+* Function Name: stack_monitor_init
+********************************************************************************
+* Summary:
+* Paints the unused stack. Call early in main().
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void stack_monitor_init(void)
+{
+    stack_monitor_paint(STACK_MONITOR_LIMIT, __get_MSP());
+    stack_monitor_update_peak(stack_monitor_lowest_used());
+}
+
+/*******************************************************************************
+* Function Name: stack_monitor_begin
+********************************************************************************
+* Summary:
+* Starts a measurement. Stack used by other code since the previous
+* measurement is folded into the overall peak and painted again, from the
+* lowest used word up to the current stack pointer, so only the writes of the
+* measured code are seen by stack_monitor_end(). The painting runs inline
+* after the last call, so no frame is left unpainted below the stack pointer.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  uint32_t - stack pointer at the start, pass to stack_monitor_end()
+*
+*******************************************************************************/
+uint32_t stack_monitor_begin(void)
+{
+    uint32_t lowest = stack_monitor_lowest_used();
+    volatile uint32_t *word;
+    volatile uint32_t *end;
+    uint32_t sp;
+
+    stack_monitor_update_peak(lowest);
+
+    sp = __get_MSP();
+    word = (volatile uint32_t *)lowest;
+    end = (volatile uint32_t *)(sp & ~3uL);
+    while (word < end)
+    {
+        *word = STACK_MONITOR_PATTERN;
+        word++;
+    }
+
+    return sp;
+}
+
+/*******************************************************************************
+* Function Name: stack_monitor_end
+********************************************************************************
+* Summary:
+* Ends a measurement and folds it into the overall peak. The stack below
+* start_sp was painted by stack_monitor_begin(), so the lowest written word
+* gives the use of the measured code. Interrupts taken in between are
+* included, as they run on the same stack. The scan runs inline, so only the
+* frame of this function itself adds to the result.
+*
+* Parameters:
+*  start_sp - value returned by stack_monitor_begin()
+*
+* Return :
+*  uint32_t - peak stack use below start_sp in bytes
+*
+*******************************************************************************/
+uint32_t stack_monitor_end(uint32_t start_sp)
+{
+    const volatile uint32_t *word = (const volatile uint32_t *)STACK_MONITOR_LIMIT;
+    const volatile uint32_t *top = (const volatile uint32_t *)STACK_MONITOR_TOP;
+    uint32_t lowest;
+
+    while ((word < top) && (STACK_MONITOR_PATTERN == *word))
+    {
+        word++;
+    }
+    lowest = (uint32_t)word;
+    stack_monitor_update_peak(lowest);
+
+    return (lowest < start_sp) ? (start_sp - lowest) : 0u;
+}
+
+/*******************************************************************************
+* Function Name: stack_monitor_get_peak
+********************************************************************************
+* Summary:
+* Returns the overall stack high-water mark.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  uint32_t - largest stack use since stack_monitor_init() in bytes
+*
+*******************************************************************************/
+uint32_t stack_monitor_get_peak(void)
+{
+    stack_monitor_update_peak(stack_monitor_lowest_used());
+
+    return stack_monitor_peak;
+}
+
+/*******************************************************************************
+* Function Name: stack_monitor_get_size
+********************************************************************************
+* Summary:
+* Returns the size of the stack region reserved by the linker script.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  uint32_t - stack size in bytes
+*
+*******************************************************************************/
+uint32_t stack_monitor_get_size(void)
+{
+    return STACK_MONITOR_TOP - STACK_MONITOR_LIMIT;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,85 @@
+/******************************************************************************
+* File Name:   stack_monitor.h
+*
+* Description: This file is the public interface of stack_monitor.c source
+*              file.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef STACK_MONITOR_H_
+#define STACK_MONITOR_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set to 0 to remove the stack painting */
+#ifndef STACK_MONITOR_ENABLE
+#define STACK_MONITOR_ENABLE               1
+#endif
+
+/* Stack a single self test may use at run time, in bytes. Peaks above it are
+ * flagged in the report.
+ */
+#ifndef STACK_MONITOR_TEST_BUDGET
+#define STACK_MONITOR_TEST_BUDGET          (512u)
+#endif
+
+/* Bytes below the stack pointer left unpainted by stack_monitor_init(),
+ * covering the frame of the painting function itself
+ */
+#define STACK_MONITOR_GUARD                (64u)
+
+#define STACK_MONITOR_PATTERN              (0xDEADBEEFuL)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void stack_monitor_init(void);
+uint32_t stack_monitor_begin(void);
+uint32_t stack_monitor_end(uint32_t start_sp);
+uint32_t stack_monitor_get_peak(void);
+uint32_t stack_monitor_get_size(void);
+
+#endif /* STACK_MONITOR_H_ */
+
+/* [] END OF FILE */
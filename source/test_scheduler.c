@@ -0,0 +1,345 @@
+/******************************************************************************
+* File Name:   test_scheduler.c
+*
+* Description: This file implements a cooperative, time sliced scheduler that
+*              runs the analog self tests periodically without operator input.
+*              Each test runs to completion; the scheduler only decides when
+*              to start it.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+#include <stdio.h>
+#include "cy_pdl.h"
+#include "self_test.h"
+#include "test_scheduler.h"
+#include "timebase.h"
+#include "uart_tx.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_SCHEDULER_SLOT_COUNT \
+    (sizeof(test_scheduler_slots) / sizeof(test_scheduler_slots[0]))
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const test_scheduler_slot_t test_scheduler_slots[] =
+{
+#if SELFTEST_ADC_ENABLE
+    { "ADC",        SELFTEST_PERIPH_ADC,        TEST_SCHEDULER_ADC_PERIOD_MS,
+            TEST_SCHEDULER_ADC_PRIORITY,   TEST_SCHEDULER_ADC_LIMIT_US },
+#endif
+#if SELFTEST_COMPARATOR_ENABLE
+    { "Comparator", SELFTEST_PERIPH_COMPARATOR, TEST_SCHEDULER_COMP_PERIOD_MS,
+            TEST_SCHEDULER_COMP_PRIORITY,  TEST_SCHEDULER_COMP_LIMIT_US },
+#endif
+#if SELFTEST_OPAMP_ENABLE
+    { "OP-AMP",     SELFTEST_PERIPH_OPAMP,      TEST_SCHEDULER_OPAMP_PERIOD_MS,
+            TEST_SCHEDULER_OPAMP_PRIORITY, TEST_SCHEDULER_OPAMP_LIMIT_US },
+#endif
+};
+
+static test_scheduler_stats_t test_scheduler_stats[TEST_SCHEDULER_SLOT_COUNT];
+static uint32_t test_scheduler_release_ms[TEST_SCHEDULER_SLOT_COUNT];
+static uint32_t test_scheduler_start_ms = 0u;
+static uint32_t test_scheduler_tick_ms = 0u;
+static uint32_t test_scheduler_tick_used_us = 0u;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static int32_t test_scheduler_pick(uint32_t now_ms);
+static void test_scheduler_run_slot(const test_scheduler_slot_t *entry);
+
+/*******************************************************************************
+* Function Name: test_scheduler_init
+********************************************************************************
+* Summary:
+* Clears the statistics and releases every slot one period from now.
+* timebase_init() must have been called before.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void test_scheduler_init(void)
+{
+    uint32_t slot;
+    uint32_t now_ms = timebase_get_ms();
+
+    for (slot = 0u; slot < TEST_SCHEDULER_SLOT_COUNT; slot++)
+    {
+        test_scheduler_stats[slot] = (test_scheduler_stats_t){ 0u };
+        test_scheduler_release_ms[slot] = now_ms + test_scheduler_slots[slot].period_ms;
+    }
+    test_scheduler_start_ms = now_ms;
+    test_scheduler_tick_ms = now_ms;
+    test_scheduler_tick_used_us = 0u;
+}
+
+/*******************************************************************************
+* Function Name: test_scheduler_pick
+********************************************************************************
+* Summary:
+* Returns the highest priority released slot whose runtime limit still fits in
+* the budget left in the current tick.
+*
+* Parameters:
+*  now_ms - current time
+*
+* Return :
+*  int32_t - slot index, or -1 if nothing may run now
+*
+*******************************************************************************/
+static int32_t test_scheduler_pick(uint32_t now_ms)
+{
+    int32_t best = -1;
+    uint32_t slot;
+
+    for (slot = 0u; slot < TEST_SCHEDULER_SLOT_COUNT; slot++)
+    {
+        const test_scheduler_slot_t *entry = &test_scheduler_slots[slot];
+
+        if ((int32_t)(now_ms - test_scheduler_release_ms[slot]) < 0)
+        {
+            continue;
+        }
+        if ((test_scheduler_tick_used_us + entry->limit_us) > TEST_SCHEDULER_TICK_BUDGET_US)
+        {
+            continue;
+        }
+        if ((best < 0) || (entry->priority < test_scheduler_slots[best].priority))
+        {
+            best = (int32_t)slot;
+        }
+    }
+
+    return best;
+}
+
+/*******************************************************************************
+* Function Name: test_scheduler_run_slot
+********************************************************************************
+* Summary:
+* Runs the test points of the peripheral of a slot for the selected reference
+* point without prompts or pass messages, so the background runs do not fill
+* the UART. Only failed test points are reported.
+*
+* Parameters:
+*  entry - slot to run
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void test_scheduler_run_slot(const test_scheduler_slot_t *entry)
+{
+    uint32_t mask = selftest_get_run_all_mask();
+    uint32_t fail_mask;
+    uint32_t id;
+    char line[64];
+
+    for (id = 0u; id < (uint32_t)SELFTEST_ID_COUNT; id++)
+    {
+        if (entry->periph != selftest_table[id].periph)
+        {
+            mask &= ~SELFTEST_MASK(id);
+        }
+    }
+
+    selftest_set_quiet(true);
+    fail_mask = selftest_run(mask);
+    selftest_set_quiet(false);
+
+    for (id = 0u; id < (uint32_t)SELFTEST_ID_COUNT; id++)
+    {
+        if (0u != (fail_mask & SELFTEST_MASK(id)))
+        {
+            (void)snprintf(line, sizeof(line), "Scheduler: %s failed\r\n", selftest_names[id]);
+            uart_tx_puts(line);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: test_scheduler_run
+********************************************************************************
+* Summary:
+* Runs at most one due test and returns. Call it from the main loop as often as
+* possible. A test that starts after its next release time has missed its
+* deadline; releases skipped that way are counted as missed deadlines as well.
+* A test that runs longer than its limit is counted as an overrun.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void test_scheduler_run(void)
+{
+    uint32_t now_ms = timebase_get_ms();
+    uint32_t start_cycles;
+    uint32_t elapsed_us;
+    int32_t slot;
+    test_scheduler_stats_t *stats;
+    const test_scheduler_slot_t *entry;
+
+    if ((now_ms - test_scheduler_tick_ms) >= TEST_SCHEDULER_TICK_MS)
+    {
+        test_scheduler_tick_ms = now_ms - ((now_ms - test_scheduler_tick_ms) % TEST_SCHEDULER_TICK_MS);
+        test_scheduler_tick_used_us = 0u;
+    }
+
+    slot = test_scheduler_pick(now_ms);
+    if (slot < 0)
+    {
+        return;
+    }
+    entry = &test_scheduler_slots[slot];
+    stats = &test_scheduler_stats[slot];
+
+    /* Implicit deadline: the test must start before its next release */
+    while ((int32_t)(now_ms - test_scheduler_release_ms[slot]) >= (int32_t)entry->period_ms)
+    {
+        test_scheduler_release_ms[slot] += entry->period_ms;
+        stats->missed_deadlines++;
+    }
+    test_scheduler_release_ms[slot] += entry->period_ms;
+
+    start_cycles = timebase_get_cycles();
+    test_scheduler_run_slot(entry);
+    elapsed_us = timebase_cycles_to_us(timebase_get_cycles() - start_cycles);
+
+    stats->runs++;
+    stats->busy_us += elapsed_us;
+    if (elapsed_us > stats->max_us)
+    {
+        stats->max_us = elapsed_us;
+    }
+    if (elapsed_us > entry->limit_us)
+    {
+        stats->overruns++;
+    }
+    test_scheduler_tick_used_us += elapsed_us;
+}
+
+/*******************************************************************************
+* Function Name: test_scheduler_get_stats
+********************************************************************************
+* Summary:
+* Returns the statistics of one slot.
+*
+* Parameters:
+*  slot - slot index
+*
+* Return :
+*  const test_scheduler_stats_t* - statistics, or NULL for an invalid slot
+*
+*******************************************************************************/
+const test_scheduler_stats_t *test_scheduler_get_stats(uint32_t slot)
+{
+    return (slot < TEST_SCHEDULER_SLOT_COUNT) ? &test_scheduler_stats[slot] : NULL;
+}
+
+/*******************************************************************************
+* Function Name: test_scheduler_get_cpu_share
+********************************************************************************
+* Summary:
+* Returns the share of CPU time a slot used since test_scheduler_init().
+*
+* Parameters:
+*  slot - slot index
+*
+* Return :
+*  uint32_t - CPU share in 1/1000
+*
+*******************************************************************************/
+uint32_t test_scheduler_get_cpu_share(uint32_t slot)
+{
+    uint32_t elapsed_ms = timebase_get_ms() - test_scheduler_start_ms;
+
+    if ((slot >= TEST_SCHEDULER_SLOT_COUNT) || (0u == elapsed_ms))
+    {
+        return 0u;
+    }
+
+    /* busy_us / (elapsed_ms * 1000) in permille */
+    return (uint32_t)(test_scheduler_stats[slot].busy_us / elapsed_ms);
+}
+
+/*******************************************************************************
+* Function Name: test_scheduler_print_stats
+********************************************************************************
+* Summary:
+* Prints runs, missed deadlines, overruns, worst case runtime and CPU share of
+* every slot.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void test_scheduler_print_stats(void)
+{
+    char line[96];
+    uint32_t slot;
+    uint32_t share;
+
+    uart_tx_puts("Test        runs   missed  overrun  max[us]  CPU[%]\r\n");
+    for (slot = 0u; slot < TEST_SCHEDULER_SLOT_COUNT; slot++)
+    {
+        share = test_scheduler_get_cpu_share(slot);
+        (void)snprintf(line, sizeof(line), "%-10s %6lu %8lu %8lu %8lu %4lu.%lu\r\n",
+                test_scheduler_slots[slot].name,
+                (unsigned long)test_scheduler_stats[slot].runs,
+                (unsigned long)test_scheduler_stats[slot].missed_deadlines,
+                (unsigned long)test_scheduler_stats[slot].overruns,
+                (unsigned long)test_scheduler_stats[slot].max_us,
+                (unsigned long)(share / 10u), (unsigned long)(share % 10u));
+        uart_tx_puts(line);
+    }
+}
+
+/* [] END OF FILE */
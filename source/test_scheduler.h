@@ -0,0 +1,136 @@
+/******************************************************************************
+* File Name:   test_scheduler.h
+*
+* Description: This file is the public interface of test_scheduler.c source
+*              file.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef TEST_SCHEDULER_H_
+#define TEST_SCHEDULER_H_
+
+#include <stdint.h>
+#include "self_test.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set to 1 to run the self tests periodically in the background */
+#ifndef TEST_SCHEDULER_ENABLE
+#define TEST_SCHEDULER_ENABLE              0
+#endif
+
+/* Length of one scheduler tick in milliseconds */
+#ifndef TEST_SCHEDULER_TICK_MS
+#define TEST_SCHEDULER_TICK_MS             (10u)
+#endif
+
+/* CPU time the self tests may use per scheduler tick, in microseconds */
+#ifndef TEST_SCHEDULER_TICK_BUDGET_US
+#define TEST_SCHEDULER_TICK_BUDGET_US      (5000u)
+#endif
+
+/* Period, priority (0 is highest) and runtime limit of each test slot */
+#ifndef TEST_SCHEDULER_ADC_PERIOD_MS
+#define TEST_SCHEDULER_ADC_PERIOD_MS       (1000u)
+#endif
+#ifndef TEST_SCHEDULER_ADC_PRIORITY
+#define TEST_SCHEDULER_ADC_PRIORITY        (0u)
+#endif
+#ifndef TEST_SCHEDULER_ADC_LIMIT_US
+#define TEST_SCHEDULER_ADC_LIMIT_US        (2000u)
+#endif
+
+#ifndef TEST_SCHEDULER_COMP_PERIOD_MS
+#define TEST_SCHEDULER_COMP_PERIOD_MS      (1000u)
+#endif
+#ifndef TEST_SCHEDULER_COMP_PRIORITY
+#define TEST_SCHEDULER_COMP_PRIORITY       (1u)
+#endif
+#ifndef TEST_SCHEDULER_COMP_LIMIT_US
+#define TEST_SCHEDULER_COMP_LIMIT_US       (2000u)
+#endif
+
+#ifndef TEST_SCHEDULER_OPAMP_PERIOD_MS
+#define TEST_SCHEDULER_OPAMP_PERIOD_MS     (2000u)
+#endif
+#ifndef TEST_SCHEDULER_OPAMP_PRIORITY
+#define TEST_SCHEDULER_OPAMP_PRIORITY      (2u)
+#endif
+#ifndef TEST_SCHEDULER_OPAMP_LIMIT_US
+#define TEST_SCHEDULER_OPAMP_LIMIT_US      (3000u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Static description of one scheduled test */
+typedef struct
+{
+    const char *name;
+    selftest_periph_t periph;   /* Test points run by the slot */
+    uint32_t period_ms;
+    uint32_t priority;
+    uint32_t limit_us;
+} test_scheduler_slot_t;
+
+/* Run time statistics of one scheduled test */
+typedef struct
+{
+    uint32_t runs;
+    uint32_t missed_deadlines;
+    uint32_t overruns;
+    uint32_t max_us;
+    uint64_t busy_us;
+} test_scheduler_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void test_scheduler_init(void);
+void test_scheduler_run(void);
+const test_scheduler_stats_t *test_scheduler_get_stats(uint32_t slot);
+uint32_t test_scheduler_get_cpu_share(uint32_t slot);
+void test_scheduler_print_stats(void);
+
+#endif /* TEST_SCHEDULER_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,199 @@
+/******************************************************************************
+* File Name:   timebase.c
+*
+* Description: This file provides a millisecond tick and a free running CPU
+*              cycle count derived from SysTick.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+#include <stdbool.h>
+#include "cy_pdl.h"
+#include "timebase.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static volatile uint32_t timebase_ms = 0u;
+static uint32_t timebase_reload = 0u;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void timebase_tick_callback(void);
+
+/*******************************************************************************
+* Function Name: timebase_tick_callback
+********************************************************************************
+* Summary:
+* SysTick callback, advances the millisecond counter.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void timebase_tick_callback(void)
+{
+    timebase_ms++;
+}
+
+/*******************************************************************************
+* Function Name: timebase_init
+********************************************************************************
+* Summary:
+* Starts SysTick from the CPU clock with a period of 1/TIMEBASE_TICK_HZ.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void timebase_init(void)
+{
+    timebase_reload = (SystemCoreClock / TIMEBASE_TICK_HZ) - 1u;
+    timebase_ms = 0u;
+
+    Cy_SysTick_Init(CY_SYSTICK_CLOCK_SOURCE_CLK_CPU, timebase_reload);
+    (void)Cy_SysTick_SetCallback(0u, &timebase_tick_callback);
+}
+
+/*******************************************************************************
+* Function Name: timebase_get_ms
+********************************************************************************
+* Summary:
+* Returns the milliseconds elapsed since timebase_init().
+*
+* Parameters:
+*  none
+*
+* Return :
+*  uint32_t - milliseconds
+*
+*******************************************************************************/
+uint32_t timebase_get_ms(void)
+{
+    return timebase_ms;
+}
+
+/*******************************************************************************
+* Function Name: timebase_advance_ms
+********************************************************************************
+* Summary:
+* Adds time during which SysTick was stopped, such as deep sleep, to the
+* millisecond counter.
+*
+* Parameters:
+*  ms - milliseconds to add
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void timebase_advance_ms(uint32_t ms)
+{
+    uint32_t intr_state = Cy_SysLib_EnterCriticalSection();
+
+    timebase_ms += ms;
+    Cy_SysLib_ExitCriticalSection(intr_state);
+}
+
+/*******************************************************************************
+* Function Name: timebase_get_cycles
+********************************************************************************
+* Summary:
+* Returns a CPU cycle count that wraps at 32 bits. Only differences between two
+* readings are meaningful. A SysTick reload whose interrupt is still pending,
+* for example while interrupts are masked, is detected from the SysTick
+* pending bit of the SCB, which reading does not clear, unlike COUNTFLAG. With
+* interrupts masked for longer than one tick, further reloads are missed.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  uint32_t - CPU cycles
+*
+*******************************************************************************/
+uint32_t timebase_get_cycles(void)
+{
+    uint32_t ms;
+    uint32_t count;
+    bool reload_pending;
+
+    /* Re-read if the tick interrupt fired between the reads */
+    do
+    {
+        ms = timebase_ms;
+        count = Cy_SysTick_GetValue();
+        reload_pending = (0u != (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk));
+    } while (ms != timebase_ms);
+
+    /* The counter reloaded but the tick interrupt has not run yet. The count
+     * read before the pending bit may be from before the reload, read again.
+     */
+    if (reload_pending)
+    {
+        count = Cy_SysTick_GetValue();
+        ms++;
+    }
+
+    return (ms * (timebase_reload + 1u)) + (timebase_reload - count);
+}
+
+/*******************************************************************************
+* Function Name: timebase_cycles_to_us
+********************************************************************************
+* Summary:
+* Converts a cycle count difference into microseconds.
+*
+* Parameters:
+*  cycles - CPU cycles
+*
+* Return :
+*  uint32_t - microseconds
+*
+*******************************************************************************/
+uint32_t timebase_cycles_to_us(uint32_t cycles)
+{
+    return cycles / (SystemCoreClock / 1000000u);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,322 @@
+/******************************************************************************
+* File Name:   uart_tx.c
+*
+* Description: This file implements interrupt driven UART transmission. Strings
+*              are copied into a ring buffer and the SCB TX FIFO level interrupt
+*              moves them to the hardware, so callers do not wait for the
+*              bytes to be shifted out.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+#include "cybsp.h"
+#include "uart_tx.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define UART_TX_INDEX_MASK                 (UART_TX_BUFFER_SIZE - 1u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static CySCB_Type *uart_tx_base = NULL;
+static uint8_t uart_tx_buffer[UART_TX_BUFFER_SIZE];
+
+/* head is written by the producer only, tail by the drain routine only */
+static volatile uint32_t uart_tx_head = 0u;
+static volatile uint32_t uart_tx_tail = 0u;
+static volatile uint32_t uart_tx_dropped = 0u;
+static uart_tx_overflow_policy_t uart_tx_policy = UART_TX_OVERFLOW_POLICY;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void uart_tx_drain(void);
+static void uart_tx_isr(void);
+
+/*******************************************************************************
+* Function Name: uart_tx_drain
+********************************************************************************
+* Summary:
+* Moves bytes from the ring buffer to the TX FIFO until either one is exhausted.
+* The TX trigger interrupt stays enabled only while data is pending.
+* Must be called from the ISR or with interrupts disabled.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void uart_tx_drain(void)
+{
+    uint32_t tail = uart_tx_tail;
+
+    while (tail != uart_tx_head)
+    {
+        if (0u == Cy_SCB_UART_Put(uart_tx_base, uart_tx_buffer[tail & UART_TX_INDEX_MASK]))
+        {
+            break;
+        }
+        tail++;
+    }
+    uart_tx_tail = tail;
+
+    Cy_SCB_ClearTxInterrupt(uart_tx_base, CY_SCB_UART_TX_TRIGGER);
+    Cy_SCB_SetTxInterruptMask(uart_tx_base,
+            (tail != uart_tx_head) ? CY_SCB_UART_TX_TRIGGER : 0u);
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_isr
+********************************************************************************
+* Summary:
+* SCB interrupt handler, refills the TX FIFO from the ring buffer.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+static void uart_tx_isr(void)
+{
+    uart_tx_drain();
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_init
+********************************************************************************
+* Summary:
+* Hooks the SCB interrupt of an initialized and enabled UART and resets the
+* ring buffer. The TX FIFO level trigger fires when the FIFO is half empty.
+*
+* Parameters:
+*  base - SCB instance configured as UART
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void uart_tx_init(CySCB_Type *base)
+{
+    const cy_stc_sysint_t uart_tx_intr_config =
+    {
+        .intrSrc = CYBSP_UART_IRQ,
+        .intrPriority = UART_TX_INTR_PRIORITY,
+    };
+
+    uart_tx_base = base;
+    uart_tx_head = 0u;
+    uart_tx_tail = 0u;
+    uart_tx_dropped = 0u;
+
+    Cy_SCB_SetTxInterruptMask(base, 0u);
+    Cy_SCB_UART_SetTxFifoLevel(base, Cy_SCB_GetFifoSize(base) / 2u);
+
+    if (CY_SYSINT_SUCCESS != Cy_SysInt_Init(&uart_tx_intr_config, &uart_tx_isr))
+    {
+        CY_ASSERT(0);
+    }
+    NVIC_ClearPendingIRQ(uart_tx_intr_config.intrSrc);
+    NVIC_EnableIRQ(uart_tx_intr_config.intrSrc);
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_set_overflow_policy
+********************************************************************************
+* Summary:
+* Selects what uart_tx_write() does when the ring buffer is full.
+*
+* Parameters:
+*  policy - overflow policy
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void uart_tx_set_overflow_policy(uart_tx_overflow_policy_t policy)
+{
+    uart_tx_policy = policy;
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_get_overflow_policy
+********************************************************************************
+* Summary:
+* Returns the active overflow policy.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  uart_tx_overflow_policy_t - overflow policy
+*
+*******************************************************************************/
+uart_tx_overflow_policy_t uart_tx_get_overflow_policy(void)
+{
+    return uart_tx_policy;
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_write
+********************************************************************************
+* Summary:
+* Queues bytes for transmission and returns without waiting for the UART.
+* Bytes that do not fit are handled according to the overflow policy. With
+* UART_TX_OVERFLOW_BLOCK the buffer is drained by polling, so it also works
+* while interrupts are disabled.
+*
+* Parameters:
+*  data - bytes to send
+*  size - number of bytes
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void uart_tx_write(const uint8_t *data, uint32_t size)
+{
+    uint32_t head = uart_tx_head;
+    uint32_t interrupt_state;
+
+    while (size > 0u)
+    {
+        if ((head - uart_tx_tail) >= UART_TX_BUFFER_SIZE)
+        {
+            if (UART_TX_OVERFLOW_BLOCK != uart_tx_policy)
+            {
+                if (UART_TX_OVERFLOW_COUNT == uart_tx_policy)
+                {
+                    uart_tx_dropped += size;
+                }
+                break;
+            }
+
+            /* Publish what is queued so far and wait for room */
+            uart_tx_head = head;
+            interrupt_state = Cy_SysLib_EnterCriticalSection();
+            uart_tx_drain();
+            Cy_SysLib_ExitCriticalSection(interrupt_state);
+            continue;
+        }
+
+        uart_tx_buffer[head & UART_TX_INDEX_MASK] = *data;
+        head++;
+        data++;
+        size--;
+    }
+
+    uart_tx_head = head;
+    Cy_SCB_SetTxInterruptMask(uart_tx_base, CY_SCB_UART_TX_TRIGGER);
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_puts
+********************************************************************************
+* Summary:
+* Queues a null terminated string for transmission.
+*
+* Parameters:
+*  string - string to send
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void uart_tx_puts(const char *string)
+{
+    const char *end = string;
+
+    while ('\0' != *end)
+    {
+        end++;
+    }
+    uart_tx_write((const uint8_t *)string, (uint32_t)(end - string));
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_flush
+********************************************************************************
+* Summary:
+* Waits until the ring buffer is empty and the last byte has left the shifter.
+* Use before entering low power modes or resetting the device.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+void uart_tx_flush(void)
+{
+    uint32_t interrupt_state;
+
+    while (uart_tx_tail != uart_tx_head)
+    {
+        interrupt_state = Cy_SysLib_EnterCriticalSection();
+        uart_tx_drain();
+        Cy_SysLib_ExitCriticalSection(interrupt_state);
+    }
+
+    while (!Cy_SCB_UART_IsTxComplete(uart_tx_base))
+    {
+    }
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_get_dropped
+********************************************************************************
+* Summary:
+* Returns the number of bytes discarded under UART_TX_OVERFLOW_COUNT.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  uint32_t - dropped byte count
+*
+*******************************************************************************/
+uint32_t uart_tx_get_dropped(void)
+{
+    return uart_tx_dropped;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,101 @@
+/******************************************************************************
+* File Name:   uart_tx.h
+*
+* Description: This file is the public interface of uart_tx.c source file.
+*
+*
+* Related Document: See README.md
+*
+*
+********************************************************************************
+* Copyright 2024-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+********************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef UART_TX_H_
+#define UART_TX_H_
+
+#include <stdint.h>
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of the TX ring buffer in bytes. Must be a power of two. */
+#ifndef UART_TX_BUFFER_SIZE
+#define UART_TX_BUFFER_SIZE                (256u)
+#endif
+
+/* Overflow policy applied after uart_tx_init(), see uart_tx_overflow_policy_t.
+ * The startup menu and several reports are longer than the buffer, so the
+ * default waits for room. Select UART_TX_OVERFLOW_DROP or
+ * UART_TX_OVERFLOW_COUNT where output may be lost but the caller must not
+ * wait for the UART.
+ */
+#ifndef UART_TX_OVERFLOW_POLICY
+#define UART_TX_OVERFLOW_POLICY            (UART_TX_OVERFLOW_BLOCK)
+#endif
+
+/* Priority of the SCB interrupt that drains the ring buffer */
+#define UART_TX_INTR_PRIORITY              (3u)
+
+#if ((UART_TX_BUFFER_SIZE & (UART_TX_BUFFER_SIZE - 1u)) != 0u)
+#error "UART_TX_BUFFER_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Behavior of uart_tx_write() when the ring buffer has no free space */
+typedef enum
+{
+    UART_TX_OVERFLOW_DROP,      /* Discard the bytes that do not fit */
+    UART_TX_OVERFLOW_COUNT,     /* Discard the bytes and count them */
+    UART_TX_OVERFLOW_BLOCK      /* Wait until the bytes fit */
+} uart_tx_overflow_policy_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void uart_tx_init(CySCB_Type *base);
+void uart_tx_set_overflow_policy(uart_tx_overflow_policy_t policy);
+uart_tx_overflow_policy_t uart_tx_get_overflow_policy(void);
+void uart_tx_write(const uint8_t *data, uint32_t size);
+void uart_tx_puts(const char *string);
+void uart_tx_flush(void);
+uint32_t uart_tx_get_dropped(void);
+
+#endif /* UART_TX_H_ */
+
+/* [] END OF FILE */